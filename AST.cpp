@@ -10,10 +10,10 @@
 #include "ASTNode.hpp"
 #include <iostream>
 
-AST::AST(Node* CST, SymbolTable* symbolTable)
-: _cst(CST), _symbolTable(symbolTable), _ast(nullptr), curScope(0), nextScopeId(1), braceDepth(0) {
+AST::AST(Node* CST, SymbolTable* symbolTable, Diagnostics &diagnostics)
+: _cst(CST), _symbolTable(symbolTable), _diagnostics(diagnostics), _ast(nullptr), curScope(0), nextScopeId(1), braceDepth(0) {
     if (!_cst || !_symbolTable) {
-        std::cerr << "AST: No CST or Symbol Table found\n";
+        _diagnostics.report(DiagnosticKind::INTERNAL, SourceSpan{}, "AST: No CST or Symbol Table found");
         return;
     }
     buildAST();
@@ -25,7 +25,7 @@ void AST::buildAST() {
 
   while (curCSTNode != nullptr) {
     ASTNode* newASTNode = nullptr;
-    const string &token = curCSTNode->name;
+    string_view token = curCSTNode->name;
 
       if (token == "function" || token == "procedure") {
             //Create Declaration Statement
@@ -46,7 +46,7 @@ void AST::buildAST() {
           newASTNode = createEndBlock(curCSTNode);
           append(tail, newASTNode);
       }
-      else if (_symbolTable->lookup(token, curScope) || _symbolTable->lookup(token, 0)) {
+      else if (_symbolTable->lookup(curCSTNode->nameId, curScope) || _symbolTable->lookup(curCSTNode->nameId, 0)) {
           newASTNode = createAssignment(curCSTNode);
           append(tail, newASTNode);
       }
@@ -79,9 +79,9 @@ void AST::buildAST() {
           append(tail, newASTNode);
       }
       else if (!token.empty()) {
-          cerr << "Debug: Unhandled token: " << token << " on line " << curCSTNode->lineNumber << endl;
-          exit(3);
-          curCSTNode = grabNext(curCSTNode);
+          _diagnostics.report(DiagnosticKind::INTERNAL, curCSTNode->span, "Debug: Unhandled token: " +
+                              string(token) + " on line " + to_string(curCSTNode->span.line()));
+          return;
       }
   }
 }
@@ -123,27 +123,27 @@ Node* AST::grabNext(Node* CST) {
 
 ASTNode* AST::createFuncProcDeclaration(Node* &CST) {
     //cout << "DEBUG: CREATING FUNC/PROC DECLARATION for " << CST->name << endl;
-  ASTNode* astDeclaration = new ASTNode {"DECLARATION", CST->lineNumber};
-  string symbolTableNodeName;
+  ASTNode* astDeclaration = new ASTNode {"DECLARATION", CST->span};
+  NameId symbolTableNameId = NO_NAME;
   if (CST->name == "function") {
-    symbolTableNodeName = CST->rightSibling->rightSibling->name;
-    if(_symbolTable->lookup(symbolTableNodeName, nextScopeId)) {
-      astDeclaration->symbol = _symbolTable->lookup(symbolTableNodeName, nextScopeId);
+    symbolTableNameId = CST->rightSibling->rightSibling->nameId;
+    if(_symbolTable->lookup(symbolTableNameId, nextScopeId)) {
+      astDeclaration->symbol = _symbolTable->lookup(symbolTableNameId, nextScopeId);
     }
     else {
-      cerr << "Error in symbol table lookup\n";
+      _diagnostics.report(DiagnosticKind::SEMANTIC, CST->span, "Error in symbol table lookup");
     }
       while (grabNext(CST)->name != "{") {
           CST = grabNext(CST);
       }
   }
   if (CST->name == "procedure") {
-      symbolTableNodeName = CST->rightSibling->name;
-      if(_symbolTable->lookup(symbolTableNodeName, nextScopeId)) {
-          astDeclaration->symbol = _symbolTable->lookup(symbolTableNodeName, nextScopeId);
+      symbolTableNameId = CST->rightSibling->nameId;
+      if(_symbolTable->lookup(symbolTableNameId, nextScopeId)) {
+          astDeclaration->symbol = _symbolTable->lookup(symbolTableNameId, nextScopeId);
       }
       else {
-          cerr << "Error in symbol table lookup\n";
+          _diagnostics.report(DiagnosticKind::SEMANTIC, CST->span, "Error in symbol table lookup");
       }
       while (grabNext(CST)->name != "{") {
           CST = grabNext(CST);
@@ -156,7 +156,7 @@ ASTNode* AST::createFuncProcDeclaration(Node* &CST) {
 vector<ASTNode*> AST::createVarDeclaration(Node*& CST) {
     //cout << "DEBUG: CREATING var DECLARATION for " << CST->name << endl;
     vector<ASTNode*> astDeclaration;
-    int declLine = CST->lineNumber;
+    SourceSpan declSpan = CST->span;
     Node* cstNode = CST->rightSibling;
     while (cstNode && cstNode->name != ";") {
         if (cstNode->name == "," || cstNode->name == "[" || cstNode->name == "]") {
@@ -168,14 +168,14 @@ vector<ASTNode*> AST::createVarDeclaration(Node*& CST) {
             cstNode = cstNode->rightSibling;
             continue;
         }
-        string varName = cstNode->name;
-        Symbol* sym = _symbolTable->lookup(varName, curScope);
+        string_view varName = cstNode->name;
+        Symbol* sym = _symbolTable->lookup(cstNode->nameId, curScope);
         if (!sym) {
-            cerr << "Error: variable `" << varName
-                      << "` not found in scope " << curScope
-                      << " at line " << cstNode->lineNumber << "\n";
+            _diagnostics.report(DiagnosticKind::SEMANTIC, cstNode->span, "Error: variable `" + string(varName) +
+                                "` not found in scope " + to_string(curScope) +
+                                " at line " + to_string(cstNode->span.line()));
         }
-        ASTNode* decl = new ASTNode("DECLARATION", declLine);
+        ASTNode* decl = new ASTNode("DECLARATION", declSpan);
         decl->symbol = sym;
         astDeclaration.push_back(decl);
         cstNode = cstNode->rightSibling;
@@ -192,7 +192,7 @@ ASTNode* AST::createBeginBlock(Node*& CST) {
         curScope = nextScopeId;
         nextScopeId++;
     }
-    ASTNode* astBBlock = new ASTNode {"BEGIN BLOCK", CST->lineNumber};
+    ASTNode* astBBlock = new ASTNode {"BEGIN BLOCK", CST->span};
     CST = grabNext(CST);
     return astBBlock;
 }
@@ -203,14 +203,14 @@ ASTNode* AST::createEndBlock(Node*& CST) {
     if (braceDepth == 0) {
         curScope = 0;
     }
-    ASTNode* astEBlock = new ASTNode {"END BLOCK", CST->lineNumber};
+    ASTNode* astEBlock = new ASTNode {"END BLOCK", CST->span};
     CST = grabNext(CST);
     return astEBlock;
 }
 
 ASTNode *AST::createPrintf(Node *&CST) {
     //cout << "DEBUG: CREATING printf for " << CST->name << endl;
-    ASTNode* astPrintf = new ASTNode {"PRINTF", CST->lineNumber};
+    ASTNode* astPrintf = new ASTNode {"PRINTF", CST->span};
     Node* cstNode = CST->rightSibling;
     while (cstNode && cstNode->name != "(") cstNode = cstNode->rightSibling;
     if (cstNode) {
@@ -222,8 +222,8 @@ ASTNode *AST::createPrintf(Node *&CST) {
             cstNode = cstNode->rightSibling;
             continue;
         }
-        ASTNode* param = new ASTNode{cstNode->name, cstNode->lineNumber};
-        Symbol* symbol = _symbolTable->lookup(cstNode->name, curScope);
+        ASTNode* param = new ASTNode{cstNode->name, cstNode->span, cstNode->nameId};
+        Symbol* symbol = _symbolTable->lookup(cstNode->nameId, curScope);
         if (symbol) {
             param->symbol = symbol;
         }
@@ -239,7 +239,7 @@ ASTNode *AST::createPrintf(Node *&CST) {
 
 ASTNode* AST::createReturn(Node*& CST) {
     //cout << "DEBUG: CREATING return for " << CST->name << endl;
-    ASTNode* astReturn = new ASTNode("RETURN", CST->lineNumber);
+    ASTNode* astReturn = new ASTNode("RETURN", CST->span);
     // Go past 'return'
     CST = CST->rightSibling;
     // move into expression
@@ -261,46 +261,46 @@ ASTNode* AST::createReturn(Node*& CST) {
 
 ASTNode* AST::createElse(Node*& CST) {
     //cout << "DEBUG: CREATING else for " << CST->name << endl;
-    ASTNode* astElse = new ASTNode("ELSE", CST->lineNumber);
+    ASTNode* astElse = new ASTNode("ELSE", CST->span);
     CST = grabNext(CST);
     return astElse;
 }
 
 ASTNode* AST::createAssignment(Node*& CST) {
-    int line = CST->lineNumber;
-    ASTNode* astAssign = new ASTNode("ASSIGNMENT", line);
+    SourceSpan span = CST->span;
+    ASTNode* astAssign = new ASTNode("ASSIGNMENT", span);
 
     // // check for array access
     if (CST->rightSibling && CST->rightSibling->name == "[") {
-        ASTNode* base = new ASTNode(CST->name, line);
-        base->symbol = _symbolTable->lookup(CST->name, curScope);
+        ASTNode* base = new ASTNode(CST->name, span, CST->nameId);
+        base->symbol = _symbolTable->lookup(CST->nameId, curScope);
         addSibling(astAssign, base);
 
         CST = CST->rightSibling; // [
-        ASTNode* lbrack = new ASTNode("[", CST->lineNumber);
+        ASTNode* lbrack = new ASTNode("[", CST->span);
         addSibling(astAssign, lbrack);
 
         CST = CST->rightSibling; // index
-        ASTNode* index = new ASTNode(CST->name, CST->lineNumber);
+        ASTNode* index = new ASTNode(CST->name, CST->span, CST->nameId);
         addSibling(astAssign, index);
 
         CST = CST->rightSibling; // ]
-        ASTNode* rbrack = new ASTNode("]", CST->lineNumber);
+        ASTNode* rbrack = new ASTNode("]", CST->span);
         addSibling(astAssign, rbrack);
 
         CST = CST->rightSibling; // =
     } else {
         // normal variable
-        std::string lhs = CST->name;
-        Symbol* lhsSym = _symbolTable->lookup(lhs, curScope);
-        if (!lhsSym) lhsSym = _symbolTable->lookup(lhs, 0);
+        std::string_view lhs = CST->name;
+        Symbol* lhsSym = _symbolTable->lookup(CST->nameId, curScope);
+        if (!lhsSym) lhsSym = _symbolTable->lookup(CST->nameId, 0);
         if (!lhsSym) {
-            std::cerr << "Debug: Assignment error: variable '" << lhs
-                      << "' not found in scope " << curScope
-                      << " at line " << line << "\n";
+            _diagnostics.report(DiagnosticKind::SEMANTIC, span, "Debug: Assignment error: variable '" + string(lhs) +
+                                "' not found in scope " + to_string(curScope) +
+                                " at line " + to_string(span.line()));
             return nullptr;
         }
-        ASTNode* lhsNode = new ASTNode(lhs, line);
+        ASTNode* lhsNode = new ASTNode(lhs, span, CST->nameId);
         lhsNode->symbol = lhsSym;
         addSibling(astAssign, lhsNode);
         CST = CST->rightSibling;
@@ -308,7 +308,7 @@ ASTNode* AST::createAssignment(Node*& CST) {
 
     // =
     if (!CST || CST->name != "=") {
-        std::cerr << "Debug: Assignment error: expected '=' after LHS\n";
+        _diagnostics.report(DiagnosticKind::SEMANTIC, span, "Debug: Assignment error: expected '=' after LHS");
         return astAssign;
     }
     CST = CST->rightSibling;
@@ -316,18 +316,18 @@ ASTNode* AST::createAssignment(Node*& CST) {
     // rhs
     if (CST && CST->name == "'") {
         // Case: char literal
-        ASTNode* quote1 = new ASTNode("'", CST->lineNumber);
+        ASTNode* quote1 = new ASTNode("'", CST->span);
         addSibling(astAssign, quote1);
 
         Node* inner = CST->rightSibling;
         if (inner) {
-            ASTNode* charNode = new ASTNode(inner->name, inner->lineNumber);
+            ASTNode* charNode = new ASTNode(inner->name, inner->span, inner->nameId);
             addSibling(astAssign, charNode);
             CST = inner;
 
             Node* closing = CST->rightSibling;
             if (closing && closing->name == "'") {
-                ASTNode* quote2 = new ASTNode("'", closing->lineNumber);
+                ASTNode* quote2 = new ASTNode("'", closing->span);
                 addSibling(astAssign, quote2);
                 CST = closing->rightSibling;
             }
@@ -335,20 +335,20 @@ ASTNode* AST::createAssignment(Node*& CST) {
     }
     else if (CST && CST->rightSibling && CST->rightSibling->name == "(") {
         // Case: Function Call
-        ASTNode* func = new ASTNode(CST->name, CST->lineNumber);
-        func->symbol = _symbolTable->lookup(CST->name, curScope);
+        ASTNode* func = new ASTNode(CST->name, CST->span, CST->nameId);
+        func->symbol = _symbolTable->lookup(CST->nameId, curScope);
         addSibling(astAssign, func);
 
         CST = CST->rightSibling; // now at "("
-        ASTNode* lparen = new ASTNode("(", CST->lineNumber);
+        ASTNode* lparen = new ASTNode("(", CST->span);
         addSibling(astAssign, lparen);
         CST = CST->rightSibling;
 
         // Arguments
         while (CST && CST->name != ")") {
             if (CST->name != ",") {
-                ASTNode* arg = new ASTNode(CST->name, CST->lineNumber);
-                if (auto sym = _symbolTable->lookup(CST->name, curScope))
+                ASTNode* arg = new ASTNode(CST->name, CST->span, CST->nameId);
+                if (auto sym = _symbolTable->lookup(CST->nameId, curScope))
                     arg->symbol = sym;
                 addSibling(astAssign, arg);
             }
@@ -356,7 +356,7 @@ ASTNode* AST::createAssignment(Node*& CST) {
         }
 
         if (CST && CST->name == ")") {
-            ASTNode* rparen = new ASTNode(")", CST->lineNumber);
+            ASTNode* rparen = new ASTNode(")", CST->span);
             addSibling(astAssign, rparen);
             CST = grabNext(CST);
         }
@@ -365,7 +365,7 @@ ASTNode* AST::createAssignment(Node*& CST) {
         ASTNode* rhs = infixToPostfixNumerical(CST, true);
         addSibling(astAssign, rhs);
     }
-    ASTNode* assign = new ASTNode("=", line);
+    ASTNode* assign = new ASTNode("=", span);
     addSibling(astAssign, assign);
     if (CST && CST->name == ";") {
         CST = grabNext(CST);
@@ -375,7 +375,7 @@ ASTNode* AST::createAssignment(Node*& CST) {
 
 ASTNode* AST::createIf(Node*& CST) {
     //cout << "DEBUG: CREATING if for " << CST->name << endl;
-    ASTNode* astIf = new ASTNode("IF", CST->lineNumber);
+    ASTNode* astIf = new ASTNode("IF", CST->span);
     while (CST && CST->name != "(") {
         CST = grabNext(CST);
     }
@@ -395,7 +395,7 @@ ASTNode* AST::createIf(Node*& CST) {
 
 ASTNode* AST::createWhile(Node*& CST) {
     //cout << "DEBUG: CREATING while for " << CST->name << endl;
-    ASTNode* astWhile = new ASTNode("WHILE", CST->lineNumber);
+    ASTNode* astWhile = new ASTNode("WHILE", CST->span);
     while (CST && CST->name != "(") {
         CST = grabNext(CST);
     }
@@ -421,7 +421,7 @@ ASTNode* AST::createFor(Node*& CST) {
     // move past (
     CST = grabNext(CST);
     // Expression 1 - assignment
-    ASTNode* astFor = new ASTNode("FOR EXPRESSION 1", CST->lineNumber);
+    ASTNode* astFor = new ASTNode("FOR EXPRESSION 1", CST->span);
     ASTNode* assignExpr = createAssignment(CST);
     if (assignExpr && assignExpr->rightSibling) {
         // Skip ASSIGNMENT node
@@ -429,7 +429,7 @@ ASTNode* AST::createFor(Node*& CST) {
         addSibling(astFor, tokens);
     }
     // Expression 2 - bool
-    ASTNode* expr2 = new ASTNode("FOR EXPRESSION 2", CST->lineNumber);
+    ASTNode* expr2 = new ASTNode("FOR EXPRESSION 2", CST->span);
     ASTNode* condExpr = infixToPostfixBoolean(CST, true);
     addSibling(expr2, condExpr);
     addChild(astFor, expr2);
@@ -438,7 +438,7 @@ ASTNode* AST::createFor(Node*& CST) {
         CST = grabNext(CST);
     }
     // Expression 3 - update
-    ASTNode* expr3 = new ASTNode("FOR EXPRESSION 3", CST->lineNumber);
+    ASTNode* expr3 = new ASTNode("FOR EXPRESSION 3", CST->span);
     ASTNode* updateExpr = infixToPostfixNumerical(CST, false);
     addSibling(expr3, updateExpr);
     addChild(expr2, expr3);
@@ -451,9 +451,9 @@ ASTNode* AST::createFor(Node*& CST) {
 
 ASTNode* AST::createCall(Node*& CST) {
     //std::cout << "DEBUG: CREATING call for " << CST->name << std::endl;
-    ASTNode* astCall = new ASTNode("CALL", CST->lineNumber);
-    ASTNode* funcName = new ASTNode(CST->name, CST->lineNumber);
-    if (Symbol* symbol = _symbolTable->lookup(CST->name, curScope)) {
+    ASTNode* astCall = new ASTNode("CALL", CST->span);
+    ASTNode* funcName = new ASTNode(CST->name, CST->span, CST->nameId);
+    if (Symbol* symbol = _symbolTable->lookup(CST->nameId, curScope)) {
         funcName->symbol = symbol;
     }
     addSibling(astCall, funcName);
@@ -461,22 +461,22 @@ ASTNode* AST::createCall(Node*& CST) {
     CST = CST->rightSibling;
     // Expect (
     if (CST && CST->name == "(") {
-        ASTNode* lparen = new ASTNode("(", CST->lineNumber);
+        ASTNode* lparen = new ASTNode("(", CST->span);
         addSibling(astCall, lparen);
         CST = CST->rightSibling;
     }
     // get args until )
     while (CST && CST->name != ")") {
         if (CST->name != ",") {
-            ASTNode* arg = new ASTNode(CST->name, CST->lineNumber);
-            if (Symbol* symbol = _symbolTable->lookup(CST->name, curScope))
+            ASTNode* arg = new ASTNode(CST->name, CST->span, CST->nameId);
+            if (Symbol* symbol = _symbolTable->lookup(CST->nameId, curScope))
                 arg->symbol = symbol;
             addSibling(astCall, arg);
         }
         CST = CST->rightSibling;
     }
     if (CST && CST->name == ")") {
-        ASTNode* rparen = new ASTNode(")", CST->lineNumber);
+        ASTNode* rparen = new ASTNode(")", CST->span);
         addSibling(astCall, rparen);
         CST = CST->rightSibling;
     }
@@ -487,7 +487,7 @@ ASTNode* AST::createCall(Node*& CST) {
     return astCall;
 }
 
-int AST::precedenceNumerical(const std::string &op) {
+int AST::precedenceNumerical(std::string_view op) {
     if (op == "*" || op == "/" || op == "%") {
         return 3;
     }
@@ -500,12 +500,12 @@ int AST::precedenceNumerical(const std::string &op) {
     return 0;
 }
 
-bool AST::isNumericalOperator(const std::string &tok) {
+bool AST::isNumericalOperator(std::string_view tok) {
     return tok == "+" || tok == "-" || tok == "*" ||
            tok == "/" || tok == "%" || tok == "=";
 }
 
-int AST::precedenceBoolean(const std::string &op) {
+int AST::precedenceBoolean(std::string_view op) {
     if (op == "!") {
         return 3;
     }
@@ -521,7 +521,7 @@ int AST::precedenceBoolean(const std::string &op) {
     return precedenceNumerical(op);
 }
 
-bool AST::isBooleanOperator(const std::string &tok) {
+bool AST::isBooleanOperator(std::string_view tok) {
     return tok == "!"  || tok == "&&" || tok == "||" ||
            tok == "==" || tok == "!=" || tok == "<" ||
            tok == "<=" || tok == ">"  || tok == ">=" || tok == "%";
@@ -532,8 +532,8 @@ ASTNode* AST::infixToPostfixNumerical(Node*& CST, bool stopOnSemi) {
     stack<ASTNode*> opstack;
     int parenDepth = 0;
     while (CST) {
-        const string &tok = CST->name;
-        int line = CST->lineNumber;
+        string_view tok = CST->name;
+        SourceSpan span = CST->span;
         if (!stopOnSemi && tok == ")" && parenDepth == 0) {
             break;  // closing paren for if and while
         }
@@ -543,12 +543,12 @@ ASTNode* AST::infixToPostfixNumerical(Node*& CST, bool stopOnSemi) {
         if ((isdigit(tok.at(0)) ||
             (tok.at(0) == '-' && tok.length() > 1 && isdigit(tok.at(1)))) || //check for negative
             isalpha(tok.at(0)) || tok == "'" || tok == "\"") {
-            output.push_back(new ASTNode{tok, line});
+            output.push_back(new ASTNode{tok, span, CST->nameId});
         }
         // consume (
         else if (tok == "(") {
             parenDepth++;
-            opstack.push(new ASTNode{tok, line});
+            opstack.push(new ASTNode{tok, span});
         }
         // consume )
         else if (tok == ")") {
@@ -564,7 +564,7 @@ ASTNode* AST::infixToPostfixNumerical(Node*& CST, bool stopOnSemi) {
         }
         // operator
         else if (isNumericalOperator(tok)) {
-            ASTNode* opNode = new ASTNode{tok, line};
+            ASTNode* opNode = new ASTNode{tok, span};
             while (!opstack.empty()
                 && isNumericalOperator(opstack.top()->name)
                 && precedenceNumerical(opstack.top()->name)
@@ -602,8 +602,8 @@ ASTNode* AST::infixToPostfixBoolean(Node*& CST, bool stopOnSemi) {
     stack<ASTNode*> opstack;
     int parenDepth = 0;
     while (CST) {
-        const string& tok = CST->name;
-        int line = CST->lineNumber;
+        string_view tok = CST->name;
+        SourceSpan span = CST->span;
         if (stopOnSemi && tok == ";") {
             break; //end of assignment
         }
@@ -612,44 +612,44 @@ ASTNode* AST::infixToPostfixBoolean(Node*& CST, bool stopOnSemi) {
         }
         // char literal
         if (tok == "'") {
-            output.push_back(new ASTNode{"'", line});
+            output.push_back(new ASTNode{"'", span});
             Node* Char = CST->rightSibling;
             if (Char) {
-                output.push_back(new ASTNode{Char->name, Char->lineNumber});
+                output.push_back(new ASTNode{Char->name, Char->span, Char->nameId});
                 CST = Char;
                 Node* closingQuote = CST->rightSibling;
                 if (closingQuote && closingQuote->name == "'") {
-                    output.push_back(new ASTNode{"'", closingQuote->lineNumber});
+                    output.push_back(new ASTNode{"'", closingQuote->span});
                     CST = closingQuote;
                 }
             }
         }
         // Case: Function call
         else if (isalpha(tok.at(0)) && CST->rightSibling && CST->rightSibling->name == "(") {
-            output.push_back(new ASTNode{tok, line}); // func name
-            output.push_back(new ASTNode{"(", CST->rightSibling->lineNumber}); // opening (
+            output.push_back(new ASTNode{tok, span, CST->nameId}); // func name
+            output.push_back(new ASTNode{"(", CST->rightSibling->span}); // opening (
             CST = CST->rightSibling->rightSibling;
 
             while (CST && CST->name != ")") {
                 if (CST->name != ",") {
-                    output.push_back(new ASTNode{CST->name, CST->lineNumber});
+                    output.push_back(new ASTNode{CST->name, CST->span, CST->nameId});
                 }
                 CST = CST->rightSibling;
             }
             if (CST && CST->name == ")") {
-                output.push_back(new ASTNode{")", CST->lineNumber});
+                output.push_back(new ASTNode{")", CST->span});
             }
         }
         else if (isdigit(tok.at(0)) ||
                  (tok.at(0) == '-' && tok.length() > 1 && isdigit(tok.at(1))) || //check for negative
                  isalpha(tok.at(0)) ||
                  tok == "[" || tok == "]" || tok == "\"") {
-            output.push_back(new ASTNode{tok, line});
+            output.push_back(new ASTNode{tok, span, CST->nameId});
         }
         // opening (
         else if (tok == "(") {
             parenDepth++;
-            opstack.push(new ASTNode{tok, line});
+            opstack.push(new ASTNode{tok, span});
         }
         // closing )
         else if (tok == ")") {
@@ -665,7 +665,7 @@ ASTNode* AST::infixToPostfixBoolean(Node*& CST, bool stopOnSemi) {
         }
         // bool operator
         else if (isBooleanOperator(tok)) {
-            ASTNode* opNode = new ASTNode{tok, line};
+            ASTNode* opNode = new ASTNode{tok, span};
             while (!opstack.empty() && opstack.top()->name != "(" &&
                    precedenceBoolean(opstack.top()->name) >= precedenceBoolean(tok)) {
                 output.push_back(opstack.top());
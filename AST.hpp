@@ -20,7 +20,9 @@
 
 class AST {
 public:
-    AST(Node* CST, SymbolTable* symbolTable);
+    // Lookup failures are reported to the diagnostics; a construct the
+    // builder cannot handle stops it, and root() is then incomplete
+    AST(Node* CST, SymbolTable* symbolTable, Diagnostics &diagnostics);
     ASTNode* root() const { return _ast; }
     void printASTWithSymbols(ASTNode *node);
     void printAST(ASTNode *node);
@@ -54,13 +56,14 @@ private:
     ASTNode* infixToPostfixBoolean(Node*& CST, bool stopOnSemi);
 
     // Post-fix Helpers:
-    int precedenceNumerical(const string &operation);
-    int precedenceBoolean(const string &operation);
-    bool isNumericalOperator(const string &token);
-    bool isBooleanOperator(const string &token);
+    int precedenceNumerical(string_view operation);
+    int precedenceBoolean(string_view operation);
+    bool isNumericalOperator(string_view token);
+    bool isBooleanOperator(string_view token);
 
   Node* _cst;
   SymbolTable* _symbolTable;
+  Diagnostics &_diagnostics;
   ASTNode* _ast;
 
   int curScope;
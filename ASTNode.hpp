@@ -10,6 +10,7 @@
  *****************************************************************************/
 
 #include <string>
+#include <string_view>
 #include <iostream>
 
 #include "SymbolTable.h"
@@ -17,14 +18,17 @@
 using namespace std;
 
 struct ASTNode {
-    string name;
-    int lineNumber;
+    // Views the same text as the CST node it came from, or a string literal
+    string_view name;
+    // Interned id carried over from the CST node, NO_NAME for built nodes
+    NameId nameId;
+    SourceSpan span;
     ASTNode* leftChild;
     ASTNode* rightSibling;
     Symbol* symbol;
 
-    ASTNode(const std::string &n, int line = 0)
-            : name(n), lineNumber(line), leftChild(nullptr), rightSibling(nullptr), symbol(nullptr) {}
+    ASTNode(std::string_view n, SourceSpan s = {}, NameId id = NO_NAME)
+            : name(n), nameId(id), span(s), leftChild(nullptr), rightSibling(nullptr), symbol(nullptr) {}
 };
 
 // Add a child node to LCRS tree
@@ -0,0 +1,154 @@
+/** ***************************************************************************
+ * @remark Byte scanning kernels used to skip over runs of characters the    *
+ *          tokenizer does not care about inside comments and literals, and  *
+ *          to count the newlines of a source. An SSE2 or AVX2 kernel is     *
+ *          picked at runtime, with a scalar fallback.                        *
+ *                                                                            *
+ * @file  ByteScan.cpp                                                        *
+ *****************************************************************************/
+
+#include "ByteScan.h"
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BYTESCAN_X86 1
+#endif
+
+static const char* scanScalar(const char* cur, const char* end, const ByteSet &set) {
+    for (; cur < end; cur++) {
+        char c = *cur;
+        if (c == set.bytes[0] || c == set.bytes[1] || c == set.bytes[2] || c == set.bytes[3]) {
+            return cur;
+        }
+    }
+    return end;
+}
+
+static size_t countScalar(const char* cur, const char* end, char c) {
+    size_t count = 0;
+    for (; cur < end; cur++) {
+        count += *cur == c;
+    }
+    return count;
+}
+
+#ifdef BYTESCAN_X86
+__attribute__((target("sse2")))
+static const char* scanSSE2(const char* cur, const char* end, const ByteSet &set) {
+    const __m128i a = _mm_set1_epi8(set.bytes[0]);
+    const __m128i b = _mm_set1_epi8(set.bytes[1]);
+    const __m128i c = _mm_set1_epi8(set.bytes[2]);
+    const __m128i d = _mm_set1_epi8(set.bytes[3]);
+    while (end - cur >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, a), _mm_cmpeq_epi8(block, b)),
+                                    _mm_or_si128(_mm_cmpeq_epi8(block, c), _mm_cmpeq_epi8(block, d)));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return cur + __builtin_ctz(mask);
+        }
+        cur += 16;
+    }
+    return scanScalar(cur, end, set);
+}
+
+__attribute__((target("avx2")))
+static const char* scanAVX2(const char* cur, const char* end, const ByteSet &set) {
+    const __m256i a = _mm256_set1_epi8(set.bytes[0]);
+    const __m256i b = _mm256_set1_epi8(set.bytes[1]);
+    const __m256i c = _mm256_set1_epi8(set.bytes[2]);
+    const __m256i d = _mm256_set1_epi8(set.bytes[3]);
+    while (end - cur >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, a), _mm256_cmpeq_epi8(block, b)),
+                                       _mm256_or_si256(_mm256_cmpeq_epi8(block, c), _mm256_cmpeq_epi8(block, d)));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return cur + __builtin_ctz(mask);
+        }
+        cur += 32;
+    }
+    return scanSSE2(cur, end, set);
+}
+
+__attribute__((target("sse2")))
+static size_t countSSE2(const char* cur, const char* end, char c) {
+    const __m128i match = _mm_set1_epi8(c);
+    size_t count = 0;
+    while (end - cur >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(block, match)));
+        cur += 16;
+    }
+    return count + countScalar(cur, end, c);
+}
+
+__attribute__((target("avx2")))
+static size_t countAVX2(const char* cur, const char* end, char c) {
+    const __m256i match = _mm256_set1_epi8(c);
+    size_t count = 0;
+    while (end - cur >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cur));
+        count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, match))));
+        cur += 32;
+    }
+    return count + countSSE2(cur, end, c);
+}
+#endif
+
+using ScanKernel = const char* (*)(const char*, const char*, const ByteSet &);
+using CountKernel = size_t (*)(const char*, const char*, char);
+
+struct SelectedKernel {
+    ScanKernel kernel;
+    CountKernel count;
+    const char* name;
+};
+
+static SelectedKernel selectKernel() {
+#ifdef BYTESCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return { scanAVX2, countAVX2, "avx2" };
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return { scanSSE2, countSSE2, "sse2" };
+    }
+#endif
+    return { scanScalar, countScalar, "scalar" };
+}
+
+static SelectedKernel selected = selectKernel();
+
+const char* scanUntil(const char* cur, const char* end, const ByteSet &set) {
+    return selected.kernel(cur, end, set);
+}
+
+size_t countByte(const char* cur, const char* end, char c) {
+    return selected.count(cur, end, c);
+}
+
+const char* scanKernelName() {
+    return selected.name;
+}
+
+bool selectScanKernel(const char* name) {
+    std::string_view wanted(name);
+    if (wanted == "scalar") {
+        selected = { scanScalar, countScalar, "scalar" };
+        return true;
+    }
+#ifdef BYTESCAN_X86
+    __builtin_cpu_init();
+    if (wanted == "sse2" && __builtin_cpu_supports("sse2")) {
+        selected = { scanSSE2, countSSE2, "sse2" };
+        return true;
+    }
+    if (wanted == "avx2" && __builtin_cpu_supports("avx2")) {
+        selected = { scanAVX2, countAVX2, "avx2" };
+        return true;
+    }
+#endif
+    return false;
+}
@@ -0,0 +1,37 @@
+/** ***************************************************************************
+ * @remark Byte scanning kernels used to skip over runs of characters the    *
+ *          tokenizer does not care about inside comments and literals, and  *
+ *          to count the newlines of a source. An SSE2 or AVX2 kernel is     *
+ *          picked at runtime, with a scalar fallback.                        *
+ *                                                                            *
+ * @file  ByteScan.h                                                          *
+ *****************************************************************************/
+
+#ifndef BYTESCAN_H
+#define BYTESCAN_H
+
+#include <cstddef>
+
+// Up to four bytes to stop on, unused slots repeat the first byte
+struct ByteSet {
+    char bytes[4];
+    constexpr ByteSet(char a) : bytes{a, a, a, a} {}
+    constexpr ByteSet(char a, char b) : bytes{a, b, a, a} {}
+    constexpr ByteSet(char a, char b, char c) : bytes{a, b, c, a} {}
+    constexpr ByteSet(char a, char b, char c, char d) : bytes{a, b, c, d} {}
+};
+
+// Returns the first position in [cur, end) holding a byte of set, or end
+const char* scanUntil(const char* cur, const char* end, const ByteSet &set);
+
+// Number of bytes equal to c in [cur, end)
+size_t countByte(const char* cur, const char* end, char c);
+
+// Name of the kernel selected for this CPU ("avx2", "sse2" or "scalar")
+const char* scanKernelName();
+
+// Switches to the named kernel, for the checks and benchmarks that compare
+// them. Returns false, keeping the current one, if this CPU cannot run it
+bool selectScanKernel(const char* name);
+
+#endif // BYTESCAN_H
@@ -0,0 +1,119 @@
+/** ***************************************************************************
+ * @remark Character classes for the tokenizer. A 256-entry table replaces   *
+ *          the <cctype> calls, and the run helpers use SSE2 compares to find *
+ *          the end of a whitespace, identifier or digit run 16 bytes at a    *
+ *          time (newlines inside a whitespace run are counted in bulk).      *
+ *                                                                            *
+ * @file  CharClass.h                                                         *
+ *****************************************************************************/
+
+#ifndef CHARCLASS_H
+#define CHARCLASS_H
+
+#include <array>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+enum CharClassBits : unsigned char {
+    CC_SPACE = 1,   // ' ', '\t', '\n', '\v', '\f', '\r'
+    CC_DIGIT = 2,   // '0'-'9'
+    CC_ALPHA = 4,   // 'a'-'z', 'A'-'Z'
+    CC_IDENT = 8,   // letters, digits and '_'
+    CC_PUNCT = 16   // printable, not alphanumeric and not a space
+};
+
+constexpr std::array<unsigned char, 256> makeCharClassTable() {
+    std::array<unsigned char, 256> table{};
+    for (int c = 0; c < 256; c++) {
+        unsigned char bits = 0;
+        if (c == ' ' || (c >= '\t' && c <= '\r')) bits |= CC_SPACE;
+        if (c >= '0' && c <= '9') bits |= CC_DIGIT | CC_IDENT;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) bits |= CC_ALPHA | CC_IDENT;
+        if (c == '_') bits |= CC_IDENT;
+        if (c > ' ' && c < 127 && !(bits & CC_IDENT)) bits |= CC_PUNCT;
+        table[c] = bits;
+    }
+    return table;
+}
+
+inline constexpr std::array<unsigned char, 256> charClassTable = makeCharClassTable();
+
+inline bool hasCharClass(char c, unsigned char bits) {
+    return (charClassTable[static_cast<unsigned char>(c)] & bits) != 0;
+}
+
+// End of the whitespace run starting at cur
+inline const char* spaceRunEnd(const char* cur, const char* end) {
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i belowTab = _mm_set1_epi8('\t' - 1);
+    const __m128i aboveCR = _mm_set1_epi8('\r' + 1);
+    while (end - cur >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        __m128i controls = _mm_and_si128(_mm_cmpgt_epi8(block, belowTab), _mm_cmplt_epi8(block, aboveCR));
+        unsigned spaces = _mm_movemask_epi8(_mm_or_si128(controls, _mm_cmpeq_epi8(block, space)));
+        if (spaces != 0xFFFF) {
+            return cur + __builtin_ctz(~spaces);
+        }
+        cur += 16;
+    }
+#endif
+    while (cur < end && hasCharClass(*cur, CC_SPACE)) {
+        cur++;
+    }
+    return cur;
+}
+
+// End of the run of letters, digits and '_' starting at cur
+inline const char* identRunEnd(const char* cur, const char* end) {
+#ifdef __SSE2__
+    const __m128i lowerCase = _mm_set1_epi8(0x20);
+    const __m128i beforeA = _mm_set1_epi8('a' - 1);
+    const __m128i afterZ = _mm_set1_epi8('z' + 1);
+    const __m128i before0 = _mm_set1_epi8('0' - 1);
+    const __m128i after9 = _mm_set1_epi8('9' + 1);
+    const __m128i underscore = _mm_set1_epi8('_');
+    while (end - cur >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        // Folding to lower case only maps 'A'-'Z' into 'a'-'z'
+        __m128i folded = _mm_or_si128(block, lowerCase);
+        __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(folded, beforeA), _mm_cmplt_epi8(folded, afterZ));
+        __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(block, before0), _mm_cmplt_epi8(block, after9));
+        __m128i ident = _mm_or_si128(_mm_or_si128(letters, digits), _mm_cmpeq_epi8(block, underscore));
+        unsigned mask = _mm_movemask_epi8(ident);
+        if (mask != 0xFFFF) {
+            return cur + __builtin_ctz(~mask);
+        }
+        cur += 16;
+    }
+#endif
+    while (cur < end && hasCharClass(*cur, CC_IDENT)) {
+        cur++;
+    }
+    return cur;
+}
+
+// End of the run of digits starting at cur
+inline const char* digitRunEnd(const char* cur, const char* end) {
+#ifdef __SSE2__
+    const __m128i before0 = _mm_set1_epi8('0' - 1);
+    const __m128i after9 = _mm_set1_epi8('9' + 1);
+    while (end - cur >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(block, before0), _mm_cmplt_epi8(block, after9));
+        unsigned mask = _mm_movemask_epi8(digits);
+        if (mask != 0xFFFF) {
+            return cur + __builtin_ctz(~mask);
+        }
+        cur += 16;
+    }
+#endif
+    while (cur < end && hasCharClass(*cur, CC_DIGIT)) {
+        cur++;
+    }
+    return cur;
+}
+
+#endif // CHARCLASS_H
@@ -0,0 +1,47 @@
+/** ***************************************************************************
+ * @remark Errors found while processing one input. Every phase reports into *
+ *          a Diagnostics list instead of printing and exiting, so a bad     *
+ *          input does not end the process and one file can report several  *
+ *          errors.                                                          *
+ *                                                                            *
+ * @file  Diagnostics.cpp                                                     *
+ *****************************************************************************/
+
+#include "Diagnostics.h"
+
+using namespace std;
+
+void Diagnostics::report(DiagnosticKind kind, SourceSpan span, string message) {
+    _diagnostics.push_back(Diagnostic{ kind, span, std::move(message) });
+    _kinds |= bit(kind);
+}
+
+bool Diagnostics::stopsBeforeSymbols() const {
+    return _kinds & (bit(DiagnosticKind::INPUT) | bit(DiagnosticKind::COMMENT) |
+                     bit(DiagnosticKind::LEXICAL) | bit(DiagnosticKind::SYNTAX));
+}
+
+void Diagnostics::clear() {
+    _diagnostics.clear();
+    _kinds = 0;
+}
+
+void Diagnostics::print(ostream &out, ostream &err) const {
+    bool streamCut = has(DiagnosticKind::LEXICAL) || has(DiagnosticKind::COMMENT);
+    for (const Diagnostic &d : _diagnostics) {
+        if (d.kind == DiagnosticKind::LEXICAL) {
+            out << d.message << "\n\n";
+        } else if (d.kind != DiagnosticKind::SYNTAX || !streamCut) {
+            err << d.message << "\n";
+        }
+    }
+    out.flush();
+    err.flush();
+}
+
+int Diagnostics::exitStatus() const {
+    if (has(DiagnosticKind::INTERNAL)) {
+        return 3;
+    }
+    return stopsBeforeSymbols() ? 1 : 0;
+}
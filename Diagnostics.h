@@ -0,0 +1,60 @@
+/** ***************************************************************************
+ * @remark Errors found while processing one input. Every phase reports into *
+ *          a Diagnostics list instead of printing and exiting, so a bad     *
+ *          input does not end the process and one file can report several  *
+ *          errors.                                                          *
+ *                                                                            *
+ * @file  Diagnostics.h                                                       *
+ *****************************************************************************/
+
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "SourceMap.h"
+
+enum class DiagnosticKind {
+    INPUT,      // the input could not be read
+    COMMENT,    // block comment left open
+    LEXICAL,    // invalid token
+    SYNTAX,
+    SEMANTIC,   // symbol table and AST checks, processing goes on after these
+    INTERNAL,   // the AST builder met a construct it cannot handle
+};
+
+struct Diagnostic {
+    DiagnosticKind kind;
+    SourceSpan span;
+    // The whole message, line number included
+    std::string message;
+};
+
+class Diagnostics {
+public:
+    void report(DiagnosticKind kind, SourceSpan span, std::string message);
+    const std::vector<Diagnostic> &all() const { return _diagnostics; }
+    bool has(DiagnosticKind kind) const { return _kinds & bit(kind); }
+    bool empty() const { return _diagnostics.empty(); }
+    // Input, comment, lexical or syntax errors, there is no tree to go on with
+    bool stopsBeforeSymbols() const;
+    void clear();
+
+    // Print in the order reported: lexical errors on out, the rest on err.
+    // A lexical error cuts the token stream short, so it is reported instead
+    // of the syntax errors that follow from that.
+    void print(std::ostream &out, std::ostream &err) const;
+    // 1 if the input stopped before the symbol table, 3 if the AST could not
+    // be built, 0 otherwise
+    int exitStatus() const;
+
+private:
+    std::vector<Diagnostic> _diagnostics;
+    // One bit per kind reported
+    unsigned _kinds = 0;
+
+    static unsigned bit(DiagnosticKind kind) { return 1u << static_cast<unsigned>(kind); }
+};
+
+#endif // DIAGNOSTICS_H
@@ -0,0 +1,92 @@
+/** ***************************************************************************
+ * @remark Minimal C++20 coroutine generator. The coroutine runs up to its   *
+ *          next co_yield each time a value is asked for, so producers can  *
+ *          hand values out straight from their loops without a queue.      *
+ *                                                                            *
+ * @file  Generator.h                                                         *
+ *****************************************************************************/
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <coroutine>
+#include <memory>
+#include <utility>
+
+template <typename T>
+class Generator {
+public:
+    struct promise_type {
+        // The yielded value lives in the suspended coroutine frame
+        const T* current = nullptr;
+
+        Generator get_return_object() {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T &value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { throw; }
+    };
+
+    // Input iterator for range-for, advancing resumes the coroutine
+    class iterator {
+    public:
+        explicit iterator(Generator* owner) : _owner(owner) {}
+        const T &operator*() const { return _owner->value(); }
+        iterator &operator++() {
+            if (!_owner->next()) {
+                _owner = nullptr;
+            }
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return _owner == other._owner; }
+
+    private:
+        Generator* _owner;
+    };
+
+    Generator() = default;
+    Generator(const Generator &) = delete;
+    Generator &operator=(const Generator &) = delete;
+    Generator(Generator &&other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+    Generator &operator=(Generator &&other) noexcept {
+        if (this != &other) {
+            destroy();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+    ~Generator() { destroy(); }
+
+    // Run to the next co_yield, false once the coroutine has finished
+    bool next() {
+        if (!_handle || _handle.done()) {
+            return false;
+        }
+        _handle.resume();
+        return !_handle.done();
+    }
+    // Last yielded value, valid until the next call to next()
+    const T &value() const { return *_handle.promise().current; }
+
+    iterator begin() { return iterator(next() ? this : nullptr); }
+    iterator end() { return iterator(nullptr); }
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+
+    explicit Generator(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+    void destroy() {
+        if (_handle) {
+            _handle.destroy();
+            _handle = nullptr;
+        }
+    }
+};
+
+#endif // GENERATOR_H
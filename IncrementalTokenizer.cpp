@@ -0,0 +1,98 @@
+/** ***************************************************************************
+ * @remark Incremental re-tokenization. After an edit only the tokens from   *
+ *          the last safe restart point before it are re-lexed, until the    *
+ *          new stream lines up with the old one again; the rest of the      *
+ *          old tokens are shifted into place.                               *
+ *                                                                            *
+ * @file  IncrementalTokenizer.cpp                                            *
+ *****************************************************************************/
+
+#include "IncrementalTokenizer.h"
+#include "Tokenizer.h"
+#include <algorithm>
+
+using namespace std;
+
+// True if tokens[i] began a new scan, false for the contents, closing quote
+// or error that getToken() queued behind an opening quote
+static bool startsScan(const vector<Token> &tokens, size_t i) {
+    switch (tokens[i].getType()) {
+        case Type::STRING:
+        case Type::ERROR_UNCLOSED_STRING:
+        case Type::ERROR_UNCLOSED_CHAR:
+            return false;
+        case Type::DOUBLE_QUOTE:
+        case Type::SINGLE_QUOTE:
+            // A quote right after the contents closes the literal
+            return i == 0 || tokens[i - 1].getType() != Type::STRING;
+        default:
+            return true;
+    }
+}
+
+size_t retokenize(vector<Token> &tokens, const char* newBegin, const char* newEnd,
+                  const SourceEdit &edit) {
+    // Restart at the last scan that began before the edit. Everything lexed
+    // before it looked at most one byte past its token, so it is unchanged.
+    size_t first = lower_bound(tokens.begin(), tokens.end(), edit.offset,
+                               [](const Token &t, uint32_t offset) { return t.getOffset() < offset; })
+                   - tokens.begin();
+    size_t restart = 0;
+    uint32_t restartOffset = 0;
+    for (size_t i = first; i > 0; i--) {
+        if (startsScan(tokens, i - 1)) {
+            restart = i - 1;
+            restartOffset = tokens[restart].getOffset();
+            break;
+        }
+    }
+
+    // Re-lex until a scan past the edit starts where an old scan started
+    int64_t shift = int64_t(edit.inserted) - int64_t(edit.removed);
+    uint32_t editEnd = edit.offset + edit.inserted;
+    FileId file = tokens.back().getSpan().file;
+    Tokenizer tokenizer(newBegin, newBegin + restartOffset, newEnd, file, namePool(), literalPool());
+    vector<Token> relexed;
+    size_t old = restart;
+    size_t resume = tokens.size();
+    while (true) {
+        Token t = tokenizer.getToken();
+        if (t.getOffset() >= editEnd) {
+            uint32_t oldOffset = uint32_t(t.getOffset() - shift);
+            while (old < tokens.size() && (tokens[old].getOffset() < oldOffset || !startsScan(tokens, old))) {
+                old++;
+            }
+            if (old < tokens.size() && tokens[old].getOffset() == oldOffset) {
+                resume = old;
+                break;
+            }
+        }
+        relexed.push_back(t);
+        while (!tokenizer.atTokenStart()) {
+            relexed.push_back(tokenizer.getToken());
+        }
+        if (t.isEndOfFile()) {
+            break;
+        }
+    }
+
+    // Untouched tokens only move to the new buffer, the tail is also shifted.
+    // Lines come from the new text from now on.
+    for (size_t i = 0; i < restart; i++) {
+        tokens[i].rebase(newBegin, 0);
+    }
+    for (size_t i = resume; i < tokens.size(); i++) {
+        tokens[i].rebase(newBegin, int32_t(shift));
+    }
+    sourceMap().lines(file).setText(newBegin, newEnd);
+    // Overwrite the stale tokens in place so the tail moves at most once
+    size_t stale = resume - restart;
+    size_t reused = min(stale, relexed.size());
+    copy(relexed.begin(), relexed.begin() + reused, tokens.begin() + restart);
+    if (relexed.size() < stale) {
+        tokens.erase(tokens.begin() + restart + reused, tokens.begin() + resume);
+    } else {
+        tokens.insert(tokens.begin() + resume, relexed.begin() + reused, relexed.end());
+    }
+    return relexed.size();
+}
@@ -0,0 +1,31 @@
+/** ***************************************************************************
+ * @remark Incremental re-tokenization. After an edit only the tokens from   *
+ *          the last safe restart point before it are re-lexed, until the    *
+ *          new stream lines up with the old one again; the rest of the      *
+ *          old tokens are shifted into place.                               *
+ *                                                                            *
+ * @file  IncrementalTokenizer.h                                              *
+ *****************************************************************************/
+
+#ifndef INCREMENTALTOKENIZER_H
+#define INCREMENTALTOKENIZER_H
+
+#include <cstdint>
+#include <vector>
+#include "Token.h"
+
+// Bytes [offset, offset + removed) of the old source replaced by `inserted`
+// new bytes, which sit at [offset, offset + inserted) in the new source
+struct SourceEdit {
+    uint32_t offset;
+    uint32_t removed;
+    uint32_t inserted;
+};
+
+// Update tokens, the full token stream (ending in END_OF_FILE) of the old
+// source, to the token stream of the new source [newBegin, newEnd). The old
+// source does not have to be alive. Returns how many tokens were re-lexed.
+size_t retokenize(std::vector<Token> &tokens, const char* newBegin, const char* newEnd,
+                  const SourceEdit &edit);
+
+#endif // INCREMENTALTOKENIZER_H
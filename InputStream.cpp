@@ -0,0 +1,49 @@
+/** ***************************************************************************
+ * @remark Sequential reader for inputs that cannot be mapped, such as stdin  *
+ *          or a pipe. Large blocks are read into a sliding window that only  *
+ *          keeps the bytes a scanner still needs, so memory stays constant.  *
+ *                                                                            *
+ * @file  InputStream.cpp                                                     *
+ *****************************************************************************/
+
+#include "InputStream.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+InputStream::InputStream(const std::string &inputFile) : _fd(-1), _ownsFd(false), _size(0), _position(0) {
+    if (inputFile == "-") {
+        _fd = STDIN_FILENO;
+    } else {
+        _fd = open(inputFile.c_str(), O_RDONLY);
+        _ownsFd = _fd >= 0;
+    }
+    _buffer.resize(2 * BLOCK_SIZE);
+}
+
+InputStream::~InputStream() {
+    if (_ownsFd) {
+        close(_fd);
+    }
+}
+
+bool InputStream::readMore(const char* keep) {
+    // Slide the kept bytes to the front, grow only if they fill the window
+    size_t kept = end() - keep;
+    _position += keep - begin();
+    memmove(_buffer.data(), keep, kept);
+    _size = kept;
+    if (_buffer.size() - _size < BLOCK_SIZE) {
+        _buffer.resize(_size + BLOCK_SIZE);
+    }
+    ssize_t n;
+    do {
+        n = read(_fd, _buffer.data() + _size, BLOCK_SIZE);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        return false;
+    }
+    _size += n;
+    return true;
+}
@@ -0,0 +1,46 @@
+/** ***************************************************************************
+ * @remark Sequential reader for inputs that cannot be mapped, such as stdin  *
+ *          or a pipe. Large blocks are read into a sliding window that only  *
+ *          keeps the bytes a scanner still needs, so memory stays constant.  *
+ *                                                                            *
+ * @file  InputStream.h                                                       *
+ *****************************************************************************/
+
+#ifndef INPUTSTREAM_H
+#define INPUTSTREAM_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class InputStream {
+public:
+    // Bytes asked from the operating system per read
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+    // "-" reads standard input, anything else is opened as a path
+    explicit InputStream(const std::string &inputFile);
+    ~InputStream();
+    InputStream(const InputStream &) = delete;
+    InputStream &operator=(const InputStream &) = delete;
+
+    bool isOpen() const { return _fd >= 0; }
+    // The window of bytes read so far and not yet dropped
+    const char* begin() const { return _buffer.data(); }
+    const char* end() const { return _buffer.data() + _size; }
+    // Offset of begin() in the whole stream
+    size_t position() const { return _position; }
+
+    // Drop the window before keep and read the next block after the rest.
+    // The window moves, keep ends up at begin(). False at end of input.
+    bool readMore(const char* keep);
+
+private:
+    int _fd;
+    bool _ownsFd;
+    std::vector<char> _buffer;
+    size_t _size;
+    size_t _position;
+};
+
+#endif // INPUTSTREAM_H
@@ -0,0 +1,98 @@
+/** ***************************************************************************
+ * @remark Reserved words of the language and a perfect hash over them,      *
+ *          generated at compile time, so that telling a keyword from an      *
+ *          identifier is one table probe and one comparison.                 *
+ *                                                                            *
+ * @file  Keywords.h                                                          *
+ *****************************************************************************/
+
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+#include <array>
+#include <string_view>
+#include "Token.h"
+
+struct Keyword {
+    std::string_view text;
+    Type type;
+};
+
+inline constexpr std::array<Keyword, 16> keywordTable = {{
+    { "return",    Type::RETURN_KEYWORD },
+    { "TRUE",      Type::BOOLEAN_TRUE },
+    { "FALSE",     Type::BOOLEAN_FALSE },
+    { "char",      Type::CHAR },
+    { "bool",      Type::BOOL },
+    { "int",       Type::INT },
+    { "getchar",   Type::GETCHAR },
+    { "void",      Type::VOID },
+    { "sizeof",    Type::SIZEOF },
+    { "if",        Type::IF },
+    { "else",      Type::ELSE },
+    { "while",     Type::WHILE },
+    { "for",       Type::FOR },
+    { "printf",    Type::PRINTF },
+    { "function",  Type::FUNCTION },
+    { "procedure", Type::PROCEDURE },
+}};
+
+// Hash on length, first and last character
+constexpr unsigned keywordSlot(std::string_view text, unsigned firstMul, unsigned lastMul) {
+    return (text.size() + static_cast<unsigned char>(text.front()) * firstMul +
+            static_cast<unsigned char>(text.back()) * lastMul) % 32;
+}
+
+struct KeywordHash {
+    unsigned firstMul;
+    unsigned lastMul;
+    size_t minLength;
+    size_t maxLength;
+    std::array<signed char, 32> slots;
+};
+
+// Search for multipliers that give every keyword its own slot
+constexpr KeywordHash makeKeywordHash() {
+    KeywordHash hash{};
+    hash.minLength = keywordTable[0].text.size();
+    for (const Keyword &kw : keywordTable) {
+        hash.minLength = kw.text.size() < hash.minLength ? kw.text.size() : hash.minLength;
+        hash.maxLength = kw.text.size() > hash.maxLength ? kw.text.size() : hash.maxLength;
+    }
+    for (unsigned firstMul = 1; firstMul < 64; firstMul++) {
+        for (unsigned lastMul = 1; lastMul < 64; lastMul++) {
+            hash.slots.fill(-1);
+            bool perfect = true;
+            for (size_t i = 0; i < keywordTable.size() && perfect; i++) {
+                unsigned slot = keywordSlot(keywordTable[i].text, firstMul, lastMul);
+                perfect = hash.slots[slot] == -1;
+                hash.slots[slot] = static_cast<signed char>(i);
+            }
+            if (perfect) {
+                hash.firstMul = firstMul;
+                hash.lastMul = lastMul;
+                return hash;
+            }
+        }
+    }
+    return hash;
+}
+
+inline constexpr KeywordHash keywordHash = makeKeywordHash();
+static_assert(keywordHash.firstMul != 0, "no perfect hash found for the keyword table");
+
+// Keyword type for text, or Type::IDENTIFIER if it is not reserved
+constexpr Type lookupKeyword(std::string_view text) {
+    if (text.size() < keywordHash.minLength || text.size() > keywordHash.maxLength) {
+        return Type::IDENTIFIER;
+    }
+    int index = keywordHash.slots[keywordSlot(text, keywordHash.firstMul, keywordHash.lastMul)];
+    if (index >= 0 && keywordTable[index].text == text) {
+        return keywordTable[index].type;
+    }
+    return Type::IDENTIFIER;
+}
+
+static_assert(lookupKeyword("procedure") == Type::PROCEDURE && lookupKeyword("main") == Type::IDENTIFIER);
+
+#endif // KEYWORDS_H
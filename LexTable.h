@@ -0,0 +1,169 @@
+/** ***************************************************************************
+ * @remark Transition table for the tokenizer DFA, built at compile time.    *
+ *          Input bytes are first mapped to a small set of lexical classes,   *
+ *          then table[state][class] gives either the next state or the Type  *
+ *          to accept (and whether the current byte belongs to the token).    *
+ *                                                                            *
+ * @file  LexTable.h                                                          *
+ *****************************************************************************/
+
+#ifndef LEXTABLE_H
+#define LEXTABLE_H
+
+#include <array>
+#include "Token.h"
+
+// Lexical classes of input bytes
+enum LexClass : unsigned char {
+    LC_INVALID,     // not a space, letter, digit or punctuation
+    LC_LETTER, LC_UNDERSCORE, LC_DIGIT,
+    LC_EQUAL, LC_BANG, LC_LESS, LC_GREATER, LC_AMPERSAND, LC_PIPE,
+    LC_MINUS, LC_PLUS, LC_STAR, LC_SLASH, LC_PERCENT,
+    LC_SEMICOLON, LC_COMMA,
+    LC_L_BRACE, LC_R_BRACE, LC_L_PAREN, LC_R_PAREN, LC_L_BRACKET, LC_R_BRACKET,
+    LC_DOUBLE_QUOTE, LC_SINGLE_QUOTE,
+    LC_OTHER_PUNCT, // punctuation that is not an operator
+    LC_SPACE,
+    LC_EOF,
+    LC_COUNT
+};
+
+// DFA states, LS_START is where every token begins
+enum LexState : unsigned char {
+    LS_START,
+    LS_IDENTIFIER,  // letters, digits, '_'
+    LS_NUMBER,      // digits, optionally after a '-'
+    LS_MINUS,       // '-' seen, a digit makes it a negative number
+    LS_EQUAL, LS_BANG, LS_LESS, LS_GREATER, LS_AMPERSAND, LS_PIPE,
+    LS_STAR,        // '*' seen, a '/' is a stray end of comment
+    LS_COUNT
+};
+
+// Table entry: a state to move to (consuming the byte) or a Type to accept
+struct LexAction {
+    unsigned char next;
+    unsigned char type;
+    bool accept;
+    bool consume;
+};
+
+constexpr LexAction lexMove(LexState next) {
+    return { static_cast<unsigned char>(next), 0, false, true };
+}
+
+// Accept type, the current byte is part of the token
+constexpr LexAction lexTake(Type type) {
+    return { LS_START, static_cast<unsigned char>(type), true, true };
+}
+
+// Accept type, the current byte starts the next token
+constexpr LexAction lexStop(Type type) {
+    return { LS_START, static_cast<unsigned char>(type), true, false };
+}
+
+constexpr std::array<unsigned char, 256> makeLexClassTable() {
+    std::array<unsigned char, 256> table{};
+    for (int c = 0; c < 256; c++) {
+        unsigned char cls = LC_INVALID;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) cls = LC_LETTER;
+        else if (c >= '0' && c <= '9') cls = LC_DIGIT;
+        else if (c == ' ' || (c >= '\t' && c <= '\r')) cls = LC_SPACE;
+        else if (c > ' ' && c < 127) cls = LC_OTHER_PUNCT;
+        table[c] = cls;
+    }
+    table['_'] = LC_UNDERSCORE;
+    table['='] = LC_EQUAL;      table['!'] = LC_BANG;
+    table['<'] = LC_LESS;       table['>'] = LC_GREATER;
+    table['&'] = LC_AMPERSAND;  table['|'] = LC_PIPE;
+    table['-'] = LC_MINUS;      table['+'] = LC_PLUS;
+    table['*'] = LC_STAR;       table['/'] = LC_SLASH;
+    table['%'] = LC_PERCENT;    table[';'] = LC_SEMICOLON;
+    table[','] = LC_COMMA;
+    table['{'] = LC_L_BRACE;    table['}'] = LC_R_BRACE;
+    table['('] = LC_L_PAREN;    table[')'] = LC_R_PAREN;
+    table['['] = LC_L_BRACKET;  table[']'] = LC_R_BRACKET;
+    table['"'] = LC_DOUBLE_QUOTE;
+    table['\''] = LC_SINGLE_QUOTE;
+    return table;
+}
+
+inline constexpr std::array<unsigned char, 256> lexClassTable = makeLexClassTable();
+
+using LexTable = std::array<std::array<LexAction, LC_COUNT>, LS_COUNT>;
+
+constexpr LexTable makeLexTable() {
+    LexTable table{};
+
+    // Start state: single character tokens are accepted right away
+    auto &start = table[LS_START];
+    start.fill(lexTake(Type::ERROR_INVALID_CHAR));
+    start[LC_OTHER_PUNCT] = lexTake(Type::ERROR_INVALID_OPERATOR);
+    start[LC_LETTER] = lexMove(LS_IDENTIFIER);
+    start[LC_UNDERSCORE] = lexMove(LS_IDENTIFIER);
+    start[LC_DIGIT] = lexMove(LS_NUMBER);
+    start[LC_MINUS] = lexMove(LS_MINUS);
+    start[LC_EQUAL] = lexMove(LS_EQUAL);
+    start[LC_BANG] = lexMove(LS_BANG);
+    start[LC_LESS] = lexMove(LS_LESS);
+    start[LC_GREATER] = lexMove(LS_GREATER);
+    start[LC_AMPERSAND] = lexMove(LS_AMPERSAND);
+    start[LC_PIPE] = lexMove(LS_PIPE);
+    start[LC_STAR] = lexMove(LS_STAR);
+    start[LC_PLUS] = lexTake(Type::PLUS);
+    start[LC_SLASH] = lexTake(Type::DIVIDE);
+    start[LC_PERCENT] = lexTake(Type::MODULO);
+    start[LC_SEMICOLON] = lexTake(Type::SEMICOLON);
+    start[LC_COMMA] = lexTake(Type::COMMA);
+    start[LC_L_BRACE] = lexTake(Type::L_BRACE);
+    start[LC_R_BRACE] = lexTake(Type::R_BRACE);
+    start[LC_L_PAREN] = lexTake(Type::L_PAREN);
+    start[LC_R_PAREN] = lexTake(Type::R_PAREN);
+    start[LC_L_BRACKET] = lexTake(Type::L_BRACKET);
+    start[LC_R_BRACKET] = lexTake(Type::R_BRACKET);
+    // Opening quotes, the literal itself is read by the quote builders
+    start[LC_DOUBLE_QUOTE] = lexTake(Type::DOUBLE_QUOTE);
+    start[LC_SINGLE_QUOTE] = lexTake(Type::SINGLE_QUOTE);
+    start[LC_EOF] = lexStop(Type::END_OF_FILE);
+
+    // Identifiers and keywords (keywords are told apart after accepting)
+    auto &identifier = table[LS_IDENTIFIER];
+    identifier.fill(lexStop(Type::IDENTIFIER));
+    identifier[LC_LETTER] = lexMove(LS_IDENTIFIER);
+    identifier[LC_UNDERSCORE] = lexMove(LS_IDENTIFIER);
+    identifier[LC_DIGIT] = lexMove(LS_IDENTIFIER);
+
+    // Integers, a letter right after the digits makes an invalid integer
+    auto &number = table[LS_NUMBER];
+    number.fill(lexStop(Type::INTEGER));
+    number[LC_DIGIT] = lexMove(LS_NUMBER);
+    number[LC_LETTER] = lexTake(Type::ERROR_INVALID_INT);
+
+    // '-' directly followed by a digit is a negative integer
+    table[LS_MINUS].fill(lexStop(Type::MINUS));
+    table[LS_MINUS][LC_DIGIT] = lexMove(LS_NUMBER);
+
+    // Two character operators
+    table[LS_EQUAL].fill(lexStop(Type::ASSIGNMENT_OPERATOR));
+    table[LS_EQUAL][LC_EQUAL] = lexTake(Type::BOOLEAN_EQUAL);
+    table[LS_BANG].fill(lexStop(Type::BOOLEAN_NOT));
+    table[LS_BANG][LC_EQUAL] = lexTake(Type::BOOLEAN_NOT_EQUAL);
+    table[LS_LESS].fill(lexStop(Type::LT));
+    table[LS_LESS][LC_EQUAL] = lexTake(Type::LT_EQUAL);
+    table[LS_GREATER].fill(lexStop(Type::GT));
+    table[LS_GREATER][LC_EQUAL] = lexTake(Type::GT_EQUAL);
+    table[LS_AMPERSAND].fill(lexStop(Type::ERROR_INVALID_OPERATOR));
+    table[LS_AMPERSAND][LC_AMPERSAND] = lexTake(Type::BOOLEAN_AND);
+    table[LS_PIPE].fill(lexStop(Type::ERROR_INVALID_OPERATOR));
+    table[LS_PIPE][LC_PIPE] = lexTake(Type::BOOLEAN_OR);
+
+    // "*/" outside of a comment
+    table[LS_STAR].fill(lexStop(Type::ASTERISK));
+    table[LS_STAR][LC_SLASH] = lexTake(Type::ERROR_UNCLOSED_COMMENT);
+    return table;
+}
+
+inline constexpr LexTable lexTable = makeLexTable();
+
+static_assert(static_cast<int>(Type::END_OF_FILE) < 256, "Type must fit in a LexAction");
+
+#endif // LEXTABLE_H
@@ -0,0 +1,92 @@
+/** ***************************************************************************
+ * @remark Pool of decoded literal values, filled by the tokenizer. Integer  *
+ *          literals are parsed once and char/string contents have their     *
+ *          escapes resolved once; equal values share one entry.             *
+ *                                                                            *
+ * @file  LiteralPool.cpp                                                     *
+ *****************************************************************************/
+
+#include "LiteralPool.h"
+#include <charconv>
+#include <string>
+
+LiteralId LiteralPool::addInteger(std::string_view text) {
+    int32_t value = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size()) {
+        return NO_LITERAL;
+    }
+    return addEntry(LiteralKind::INTEGER, value, static_cast<uint32_t>(value), std::string_view());
+}
+
+LiteralId LiteralPool::addCharacter(std::string_view raw) {
+    return addDecoded(LiteralKind::CHARACTER, raw);
+}
+
+LiteralId LiteralPool::addString(std::string_view raw) {
+    return addDecoded(LiteralKind::STRING, raw);
+}
+
+LiteralId LiteralPool::add(const Literal &literal) {
+    if (literal.kind == LiteralKind::INTEGER) {
+        return addEntry(literal.kind, literal.value, static_cast<uint32_t>(literal.value), std::string_view());
+    }
+    NameId bytesId = _bytes.intern(literal.bytes);
+    return addEntry(literal.kind, literal.value, bytesId, _bytes.spelling(bytesId));
+}
+
+LiteralId LiteralPool::addEntry(LiteralKind kind, int32_t value, uint32_t key, std::string_view bytes) {
+    uint64_t fullKey = (uint64_t(kind) << 32) | key;
+    auto found = _ids.find(fullKey);
+    if (found != _ids.end()) {
+        return found->second;
+    }
+    LiteralId id = static_cast<LiteralId>(_literals.size());
+    _literals.push_back(Literal{ kind, value, bytes });
+    _ids.emplace(fullKey, id);
+    return id;
+}
+
+// Value of the escape sequence '\c'
+static char escapedChar(char c) {
+    switch (c) {
+        case 'n':  return '\n';
+        case 't':  return '\t';
+        case 'r':  return '\r';
+        case '0':  return '\0';
+        case 'a':  return '\a';
+        case 'b':  return '\b';
+        case 'f':  return '\f';
+        case 'v':  return '\v';
+        default:   return c;    // \\, \', \" and unknown escapes
+    }
+}
+
+LiteralId LiteralPool::addDecoded(LiteralKind kind, std::string_view raw) {
+    NameId bytesId;
+    if (raw.find('\\') == std::string_view::npos) {
+        bytesId = _bytes.intern(raw);
+    }
+    else {
+        std::string decoded;
+        decoded.reserve(raw.size());
+        for (size_t i = 0; i < raw.size(); i++) {
+            if (raw[i] != '\\' || i + 1 == raw.size()) {
+                decoded += raw[i];
+            }
+            // Backslash-newline continues the literal on the next line
+            else if (raw[++i] != '\n') {
+                decoded += escapedChar(raw[i]);
+            }
+        }
+        bytesId = _bytes.intern(decoded);
+    }
+    std::string_view bytes = _bytes.spelling(bytesId);
+    int32_t value = bytes.empty() ? 0 : static_cast<unsigned char>(bytes[0]);
+    return addEntry(kind, value, bytesId, bytes);
+}
+
+LiteralPool &literalPool() {
+    static LiteralPool pool;
+    return pool;
+}
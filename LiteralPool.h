@@ -0,0 +1,64 @@
+/** ***************************************************************************
+ * @remark Pool of decoded literal values, filled by the tokenizer. Integer  *
+ *          literals are parsed once and char/string contents have their     *
+ *          escapes resolved once; equal values share one entry.             *
+ *                                                                            *
+ * @file  LiteralPool.h                                                       *
+ *****************************************************************************/
+
+#ifndef LITERALPOOL_H
+#define LITERALPOOL_H
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "NamePool.h"
+
+using LiteralId = uint32_t;
+// Id of tokens that are not literals
+constexpr LiteralId NO_LITERAL = UINT32_MAX;
+
+enum class LiteralKind { INTEGER, CHARACTER, STRING };
+
+struct Literal {
+    LiteralKind kind;
+    // Integers: the value, characters: the first decoded byte
+    int32_t value;
+    // Characters and strings: the decoded bytes
+    std::string_view bytes;
+};
+
+class LiteralPool {
+public:
+    LiteralPool() = default;
+    LiteralPool(const LiteralPool &) = delete;
+    LiteralPool &operator=(const LiteralPool &) = delete;
+
+    // Integer literal text (digits, optionally negative), NO_LITERAL if the
+    // value does not fit in an int
+    LiteralId addInteger(std::string_view text);
+    // Contents of a char or string literal as they appear in the source
+    LiteralId addCharacter(std::string_view raw);
+    LiteralId addString(std::string_view raw);
+    // Entry equal to one taken from another pool
+    LiteralId add(const Literal &literal);
+
+    const Literal &get(LiteralId id) const { return _literals[id]; }
+    size_t size() const { return _literals.size(); }
+
+private:
+    // Decoded bytes are interned, which also deduplicates them
+    NamePool _bytes;
+    std::vector<Literal> _literals;
+    // (kind, value) for integers, (kind, bytes id) otherwise
+    std::unordered_map<uint64_t, LiteralId> _ids;
+
+    LiteralId addEntry(LiteralKind kind, int32_t value, uint32_t key, std::string_view bytes);
+    LiteralId addDecoded(LiteralKind kind, std::string_view raw);
+};
+
+// Pool shared by the tokenizer and the later phases
+LiteralPool &literalPool();
+
+#endif // LITERALPOOL_H
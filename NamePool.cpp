@@ -0,0 +1,47 @@
+/** ***************************************************************************
+ * @remark Interning pool for identifier spellings. Every distinct spelling  *
+ *          gets a dense 32-bit id that the symbol table and AST compare     *
+ *          instead of the text itself.                                      *
+ *                                                                            *
+ * @file  NamePool.cpp                                                        *
+ *****************************************************************************/
+
+#include "NamePool.h"
+#include <cstring>
+
+NameId NamePool::intern(std::string_view text) {
+    auto found = _ids.find(text);
+    if (found != _ids.end()) {
+        return found->second;
+    }
+    NameId id = static_cast<NameId>(_spellings.size());
+    std::string_view stored = store(text);
+    _spellings.push_back(stored);
+    _ids.emplace(stored, id);
+    return id;
+}
+
+NameId NamePool::find(std::string_view text) const {
+    auto found = _ids.find(text);
+    return found == _ids.end() ? NO_NAME : found->second;
+}
+
+std::string_view NamePool::store(std::string_view text) {
+    if (text.empty()) {
+        return std::string_view();
+    }
+    // Spellings longer than a block get a block of their own
+    if (_blockUsed + text.size() > BLOCK_SIZE) {
+        _blocks.emplace_back(new char[text.size() > BLOCK_SIZE ? text.size() : BLOCK_SIZE]);
+        _blockUsed = 0;
+    }
+    char* dest = _blocks.back().get() + _blockUsed;
+    memcpy(dest, text.data(), text.size());
+    _blockUsed += text.size();
+    return std::string_view(dest, text.size());
+}
+
+NamePool &namePool() {
+    static NamePool pool;
+    return pool;
+}
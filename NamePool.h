@@ -0,0 +1,51 @@
+/** ***************************************************************************
+ * @remark Interning pool for identifier spellings. Every distinct spelling  *
+ *          gets a dense 32-bit id that the symbol table and AST compare     *
+ *          instead of the text itself.                                      *
+ *                                                                            *
+ * @file  NamePool.h                                                          *
+ *****************************************************************************/
+
+#ifndef NAMEPOOL_H
+#define NAMEPOOL_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using NameId = uint32_t;
+// Id of text that was never interned (punctuation, numbers, ...)
+constexpr NameId NO_NAME = UINT32_MAX;
+
+class NamePool {
+public:
+    NamePool() = default;
+    NamePool(const NamePool &) = delete;
+    NamePool &operator=(const NamePool &) = delete;
+
+    // Id of text, adding it to the pool the first time it is seen
+    NameId intern(std::string_view text);
+    // Id of text, or NO_NAME if it was never interned
+    NameId find(std::string_view text) const;
+    // The pooled copy of an id's spelling, valid as long as the pool is
+    std::string_view spelling(NameId id) const { return _spellings[id]; }
+    size_t size() const { return _spellings.size(); }
+
+private:
+    // Spellings are copied into fixed blocks so views into them never move
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    size_t _blockUsed = BLOCK_SIZE;
+
+    std::vector<std::string_view> _spellings;
+    std::unordered_map<std::string_view, NameId> _ids;
+
+    std::string_view store(std::string_view text);
+};
+
+// Pool shared by the tokenizer, parser, symbol table and AST
+NamePool &namePool();
+
+#endif // NAMEPOOL_H
@@ -2,26 +2,39 @@
 #ifndef NODE_H
 #define NODE_H
 
+#include <cstdlib>
+#include <initializer_list>
 #include <string>
+#include <string_view>
 #include <iostream>
+#include "NamePool.h"
+#include "LiteralPool.h"
+#include "SourceMap.h"
+#include "NodeArena.h"
 
 using namespace std;
 
 struct Node {
     static inline int globalID = 0;
+    // View into the source buffer (terminals) or a string literal (nonterminals)
+    string_view name;
+    // Interned id of the name for identifier/keyword/string terminals, else NO_NAME
+    NameId nameId;
+    // Decoded value of integer and char/string content terminals, else NO_LITERAL
+    LiteralId literal;
+    // Source covered, from the first token to the last
+    SourceSpan span;
     int id;
-    string name;
-    int lineNumber;
     Node* leftChild;
     Node* rightSibling;
 
-    Node(const std::string &n, int line = 0)
-        : name(n), lineNumber(line), leftChild(nullptr), rightSibling(nullptr) {
-        id = globalID++;
+    Node(std::string_view n, SourceSpan s = {}, NameId nid = NO_NAME, LiteralId lit = NO_LITERAL)
+        : name(n), nameId(nid), literal(lit), span(s), leftChild(nullptr), rightSibling(nullptr) {
+        this->id = globalID++;
     }
 
     void printTree(int indent = 0) const {
-        std::cout << std::string(indent, ' ') << name << " (line " << lineNumber << ")\n";
+        std::cout << std::string(indent, ' ') << name << " (line " << span.line() << ")\n";
         if (leftChild) {
             leftChild->printTree(indent + 2);
         }
@@ -30,35 +43,62 @@ struct Node {
         }
     }
 
-    Node* clone() const {
-        Node* copy = new Node(this->name, this->lineNumber);
+    Node* clone(NodeArena &arena) const {
+        Node* copy = arena.make<Node>(this->name, this->span, this->nameId, this->literal);
         // Optionally copy ID if needed
         copy->id = this->id;
         return copy;
     }
 };
 
-// Add a child node to lcrs tree
-inline void addChild(Node* parent, Node* child) {
-    if (!parent || !child) return;
-    if (!parent->leftChild) {
-        parent->leftChild = child;
-    } else {
-        Node* tmp = parent->leftChild;
-        while (tmp->rightSibling != nullptr) {
-            tmp = tmp->rightSibling;
+// Children of a node being built. Each append links the child onto the
+// sibling chain and remembers the tail, so k children are linked in O(k).
+// Building with VALIDATE_TREES defined also rejects a child that is already
+// in a chain, which would otherwise splice trees together or make a cycle.
+class ChildList {
+public:
+    ChildList() = default;
+    ChildList(std::initializer_list<Node*> children) {
+        for (Node* child : children) {
+            push_back(child);
         }
-        tmp->rightSibling = child;
     }
-}
 
-// Add a sibling node to the lcrs tree
-inline void addSibling(Node* leftNode, Node* sibling) {
-    if (!leftNode || !sibling) return;
-    while (leftNode->rightSibling) {
-        leftNode = leftNode->rightSibling;
+    void push_back(Node* child) {
+        if (!child) {
+            _hasNull = true;
+            return;
+        }
+#ifdef VALIDATE_TREES
+        for (Node* n = _head; n; n = n->rightSibling) {
+            if (n == child) {
+                std::cerr << "[ERROR] Duplicate child pointer detected while building "
+                          << child->name << "\n";
+                exit(1);
+            }
+        }
+        if (child->rightSibling) {
+            std::cerr << "[ERROR] Circular reference while attaching " << child->name << "\n";
+            exit(1);
+        }
+#endif
+        if (_tail) {
+            _tail->rightSibling = child;
+        } else {
+            _head = child;
+        }
+        _tail = child;
     }
-    leftNode->rightSibling = sibling;
-}
+    bool empty() const { return !_head; }
+    Node* front() const { return _head; }
+    Node* back() const { return _tail; }
+    // A null child was appended (and left out)
+    bool hasNull() const { return _hasNull; }
+
+private:
+    Node* _head = nullptr;
+    Node* _tail = nullptr;
+    bool _hasNull = false;
+};
 
 #endif
\ No newline at end of file
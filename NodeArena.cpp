@@ -0,0 +1,26 @@
+/** ***************************************************************************
+ * @remark Bump-pointer arena for tree nodes. Objects are carved out of big  *
+ *          blocks one after the other and are never freed one by one; the  *
+ *          whole arena is released at once when it is reset or destroyed.  *
+ *                                                                            *
+ * @file  NodeArena.cpp                                                       *
+ *****************************************************************************/
+
+#include "NodeArena.h"
+
+void* NodeArena::allocateSlow(size_t size, size_t align) {
+    _used += _cur - _blockStart;
+    _blocks.emplace_back(new char[BLOCK_SIZE]);
+    _blockStart = _cur = _blocks.back().get();
+    _end = _blockStart + BLOCK_SIZE;
+    return allocate(size, align);
+}
+
+void NodeArena::reset() {
+    if (_blocks.size() > 1) {
+        _blocks.resize(1);
+    }
+    _used = 0;
+    _blockStart = _cur = _blocks.empty() ? nullptr : _blocks.front().get();
+    _end = _blockStart ? _blockStart + BLOCK_SIZE : nullptr;
+}
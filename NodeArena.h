@@ -0,0 +1,67 @@
+/** ***************************************************************************
+ * @remark Bump-pointer arena for tree nodes. Objects are carved out of big  *
+ *          blocks one after the other and are never freed one by one; the  *
+ *          whole arena is released at once when it is reset or destroyed.  *
+ *                                                                            *
+ * @file  NodeArena.h                                                         *
+ *****************************************************************************/
+
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class NodeArena {
+public:
+    NodeArena() = default;
+    NodeArena(const NodeArena &) = delete;
+    NodeArena &operator=(const NodeArena &) = delete;
+
+    // Construct a T in the arena. Destructors are never run, so only types
+    // that do not need one can live here.
+    template <typename T, typename... Args>
+    T* make(Args &&...args) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena objects are never destroyed");
+        static_assert(sizeof(T) + alignof(T) <= BLOCK_SIZE, "too big for an arena block");
+        void* place = heapPerObject ? ::operator new(sizeof(T)) : allocate(sizeof(T), alignof(T));
+        return new (place) T(std::forward<Args>(args)...);
+    }
+    // Drop every object at once. The first block is kept for the next use,
+    // so a process parsing file after file does not go back to malloc.
+    void reset();
+    // Bytes handed out since the last reset
+    size_t bytesUsed() const { return _used + (_cur - _blockStart); }
+    // Give every object its own operator new and never free it, the way
+    // nodes were allocated before the arena. Only the benchmark that
+    // compares the two turns this on.
+    static void setHeapPerObject(bool on) { heapPerObject = on; }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+    static inline bool heapPerObject = false;
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    // Block being carved up, and the bytes handed out from earlier blocks
+    char* _blockStart = nullptr;
+    char* _cur = nullptr;
+    char* _end = nullptr;
+    size_t _used = 0;
+
+    void* allocate(size_t size, size_t align) {
+        uintptr_t p = (reinterpret_cast<uintptr_t>(_cur) + align - 1) & ~uintptr_t(align - 1);
+        if (p + size > reinterpret_cast<uintptr_t>(_end)) {
+            return allocateSlow(size, align);
+        }
+        _cur = reinterpret_cast<char*>(p + size);
+        return reinterpret_cast<void*>(p);
+    }
+    // Start a new block, the rest of the current one is left unused
+    void* allocateSlow(size_t size, size_t align);
+};
+
+#endif // NODEARENA_H
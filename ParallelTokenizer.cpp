@@ -0,0 +1,185 @@
+/** ***************************************************************************
+ * @remark Speculative parallel tokenization. The source is split at line   *
+ *          starts, every chunk is lexed on its own thread as if it began    *
+ *          outside any comment or literal, and chunks are stitched back     *
+ *          together in order, re-lexing only where a guess was wrong.       *
+ *                                                                            *
+ * @file  ParallelTokenizer.cpp                                               *
+ *****************************************************************************/
+
+#include "ParallelTokenizer.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+using namespace std;
+
+// Speculative tokens of one chunk
+struct LexChunk {
+    const char* begin = nullptr;   // a line start
+    const char* limit = nullptr;   // begin of the next chunk, nullptr for the last one
+    // Words and literals are pooled per chunk and moved into namePool() and
+    // literalPool() while merging, in token order, so ids come out the same
+    // as a serial run
+    NamePool names;
+    LiteralPool literals;
+    vector<Token> tokens;
+    // tokens[i] started a new scan, as opposed to the rest of a quoted literal
+    vector<char> restart;
+    // First token start at or past limit
+    uint32_t endOffset = 0;
+};
+
+// Lex from chunk.begin, guessing that it is not inside a comment or literal,
+// until a token starts at or past the chunk limit. Tokens may run past it.
+static void lexChunk(const char* base, const char* end, FileId file, LexChunk &chunk) {
+    Tokenizer tokenizer(base, chunk.begin, end, file, chunk.names, chunk.literals);
+    uint32_t limit = chunk.limit ? chunk.limit - base : UINT32_MAX;
+    while (true) {
+        bool restart = tokenizer.atTokenStart();
+        Token token = tokenizer.getToken();
+        if (restart && token.getOffset() >= limit) {
+            chunk.endOffset = token.getOffset();
+            return;
+        }
+        chunk.tokens.push_back(token);
+        chunk.restart.push_back(restart);
+        if (token.isEndOfFile()) {
+            return;
+        }
+    }
+}
+
+// Index of the first token at or after i that starts a scan at or past offset
+static size_t nextRestart(const LexChunk &chunk, size_t i, uint32_t offset) {
+    while (i < chunk.tokens.size() && (!chunk.restart[i] || chunk.tokens[i].getOffset() < offset)) {
+        i++;
+    }
+    return i;
+}
+
+// Append chunk tokens from index i on with global ids
+static void appendChunk(const LexChunk &chunk, size_t i, vector<Token> &out) {
+    vector<NameId> globalIds(chunk.names.size(), NO_NAME);
+    vector<LiteralId> globalLiterals(chunk.literals.size(), NO_LITERAL);
+    for (; i < chunk.tokens.size(); i++) {
+        const Token &t = chunk.tokens[i];
+        NameId id = t.getNameId();
+        if (id != NO_NAME) {
+            if (globalIds[id] == NO_NAME) {
+                globalIds[id] = namePool().intern(chunk.names.spelling(id));
+            }
+            id = globalIds[id];
+        }
+        LiteralId literal = t.getLiteral();
+        if (literal != NO_LITERAL) {
+            if (globalLiterals[literal] == NO_LITERAL) {
+                globalLiterals[literal] = literalPool().add(chunk.literals.get(literal));
+            }
+            literal = globalLiterals[literal];
+        }
+        out.push_back(Token(t.getType(), t.getText().data(), t.getSpan(), id, literal));
+    }
+}
+
+static vector<Token> tokenizeSerial(Tokenizer &tokenizer) {
+    vector<Token> tokens;
+    while (true) {
+        tokens.push_back(tokenizer.getToken());
+        if (tokens.back().isEndOfFile()) {
+            return tokens;
+        }
+    }
+}
+
+vector<Token> tokenizeParallel(Tokenizer &tokenizer, unsigned threads, size_t minChunk) {
+    const char* base = tokenizer.sourceBegin();
+    const char* end = tokenizer.sourceEnd();
+    FileId file = tokenizer.file();
+    size_t size = end - base;
+    size_t chunkCount = min<size_t>(threads, size / max<size_t>(minChunk, 1));
+    if (chunkCount <= 1) {
+        return tokenizeSerial(tokenizer);
+    }
+
+    // Chunks start right after a newline near each even split point
+    vector<const char*> starts = { base };
+    for (size_t k = 1; k < chunkCount; k++) {
+        const char* target = base + size * k / chunkCount;
+        if (target <= starts.back()) {
+            continue;
+        }
+        const char* newline = static_cast<const char*>(memchr(target, '\n', end - target));
+        if (!newline || newline + 1 >= end) {
+            break;
+        }
+        if (newline + 1 > starts.back()) {
+            starts.push_back(newline + 1);
+        }
+    }
+    if (starts.size() == 1) {
+        return tokenizeSerial(tokenizer);
+    }
+
+    vector<LexChunk> chunks(starts.size());
+    for (size_t k = 0; k < chunks.size(); k++) {
+        chunks[k].begin = starts[k];
+        chunks[k].limit = k + 1 < starts.size() ? starts[k + 1] : nullptr;
+    }
+    vector<thread> workers;
+    for (size_t k = 1; k < chunks.size(); k++) {
+        workers.emplace_back(lexChunk, base, end, file, ref(chunks[k]));
+    }
+    lexChunk(base, end, file, chunks[0]);
+    for (thread &worker : workers) {
+        worker.join();
+    }
+
+    // The first chunk starts at the top of the file, so its guess is right
+    vector<Token> out;
+    size_t guessed = 0;
+    for (const LexChunk &chunk : chunks) {
+        guessed += chunk.tokens.size();
+    }
+    out.reserve(guessed + 1);
+    appendChunk(chunks[0], 0, out);
+    uint32_t pos = chunks[0].endOffset;
+
+    for (size_t k = 1; k < chunks.size(); k++) {
+        LexChunk &chunk = chunks[k];
+        uint32_t limit = chunk.limit ? chunk.limit - base : UINT32_MAX;
+        // pos is where the previous chunk really stopped. If the guess for this
+        // chunk also has a token starting there, the rest of it is right as is.
+        size_t i = nextRestart(chunk, 0, pos);
+        bool synced = i < chunk.tokens.size() && chunk.tokens[i].getOffset() == pos;
+        if (!synced) {
+            // Re-lex from pos until a token start lines up with the guess again
+            Tokenizer relex(base, base + pos, end, file, namePool(), literalPool());
+            while (true) {
+                Token t = relex.getToken();
+                if (t.getOffset() >= limit) {
+                    // The whole chunk was covered, e.g. by a long block comment
+                    pos = t.getOffset();
+                    break;
+                }
+                i = nextRestart(chunk, i, t.getOffset());
+                if (i < chunk.tokens.size() && chunk.tokens[i].getOffset() == t.getOffset()) {
+                    synced = true;
+                    break;
+                }
+                out.push_back(t);
+                while (!relex.atTokenStart()) {
+                    out.push_back(relex.getToken());
+                }
+                if (t.isEndOfFile()) {
+                    return out;
+                }
+            }
+        }
+        if (synced) {
+            appendChunk(chunk, i, out);
+            pos = chunk.endOffset;
+        }
+    }
+    return out;
+}
@@ -0,0 +1,28 @@
+/** ***************************************************************************
+ * @remark Speculative parallel tokenization. The source is split at line   *
+ *          starts, every chunk is lexed on its own thread as if it began    *
+ *          outside any comment or literal, and chunks are stitched back     *
+ *          together in order, re-lexing only where a guess was wrong.       *
+ *                                                                            *
+ * @file  ParallelTokenizer.h                                                 *
+ *****************************************************************************/
+
+#ifndef PARALLELTOKENIZER_H
+#define PARALLELTOKENIZER_H
+
+#include <cstddef>
+#include <vector>
+#include "Token.h"
+#include "Tokenizer.h"
+
+// Inputs are not split into chunks smaller than this
+constexpr size_t MIN_LEX_CHUNK = 256 * 1024;
+
+// All tokens of tokenizer's source up to and including END_OF_FILE, exactly
+// as repeated getToken() calls would return them (interned ids included).
+// The tokenizer must not have returned any tokens yet. Small inputs, or a
+// single thread, are tokenized serially.
+std::vector<Token> tokenizeParallel(Tokenizer &tokenizer, unsigned threads,
+                                    size_t minChunk = MIN_LEX_CHUNK);
+
+#endif // PARALLELTOKENIZER_H
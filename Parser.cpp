@@ -1,8 +1,10 @@
 #include "Parser.h"
+#include "Keywords.h"
+#include <algorithm>
 #include <queue>
 
-Parser::Parser(TokenList &tokens)
-    : m_tokens(tokens)
+Parser::Parser(TokenList &tokens, Diagnostics &diagnostics)
+    : m_tokens(tokens), m_diagnostics(diagnostics)
 {}
 
 Node* Parser::parse() {
@@ -10,10 +12,31 @@ Node* Parser::parse() {
     return root;
 }
 
-Token Parser::currentToken() {
+// Returned by reference when the token list runs out
+static const Token noToken(Type::END_OF_FILE, "", -1);
+
+// FIRST sets and lookahead sets of the grammar, on top of the categories
+// generated from the token specification
+static constexpr TypeSet FIRST_STATEMENT = DATATYPE_TYPES |
+    typeSet(Type::IF, Type::WHILE, Type::FOR, Type::RETURN_KEYWORD,
+            Type::PRINTF, Type::IDENTIFIER, Type::L_BRACE);
+// Ends an expression when not inside parentheses
+static constexpr TypeSet EXPRESSION_END =
+    typeSet(Type::SEMICOLON, Type::COMMA, Type::R_PAREN, Type::R_BRACKET, Type::R_BRACE);
+// Any of these makes an expression boolean rather than numerical
+static constexpr TypeSet BOOLEAN_MARKERS = BOOLEAN_OPERATOR_TYPES | RELATIONAL_OPERATOR_TYPES |
+    BOOLEAN_TYPES | typeBit(Type::BOOLEAN_NOT);
+// Second token of a comparison <operand> <op> ..., != is left to the later rules
+static constexpr TypeSet COMPARISON_LOOKAHEAD =
+    typeSet(Type::BOOLEAN_EQUAL, Type::LT_EQUAL, Type::GT_EQUAL, Type::LT, Type::GT);
+// Third token of a parenthesized arithmetic comparison ( <id> <op> ...
+static constexpr TypeSet ARITHMETIC_LOOKAHEAD =
+    typeSet(Type::PLUS, Type::MINUS, Type::ASTERISK, Type::DIVIDE, Type::MODULO);
+
+const Token& Parser::currentToken() {
     if (m_tokens.empty()) {
         std::cerr << "[ERROR] Token list empty when calling currentToken()\n";
-        return Token(Type::END_OF_FILE, "", -1);
+        return noToken;
     }
     return m_tokens.front();
 }
@@ -25,23 +48,71 @@ void Parser::advance() {
 }
 
 void Parser::error(const std::string &msg) {
-    std::cerr << msg << std::endl;
-    exit(1);
+    m_diagnostics.report(DiagnosticKind::SYNTAX, currentToken().getSpan(), msg);
+    throw ParseError{};
+}
+
+// Panic mode: skip the rest of the statement the error was found in, up to
+// and including its ';' or the block it opened, along with any else part.
+// Stops in front of the '}' closing the enclosing block.
+void Parser::recoverStatement() {
+    int depth = 0;
+    while (!check(Type::END_OF_FILE)) {
+        Type t = currentToken().getType();
+        if (t == Type::R_BRACE && depth == 0) {
+            return;
+        }
+        bool ends = (t == Type::SEMICOLON && depth == 0) || (t == Type::R_BRACE && depth == 1);
+        if (t == Type::L_BRACE) {
+            depth++;
+        } else if (t == Type::R_BRACE) {
+            depth--;
+        }
+        advance();
+        if (ends && !check(Type::ELSE)) {
+            return;
+        }
+    }
 }
 
-Token Parser::peekNext() {
+// Skip to the next function or procedure, or a global declaration after a
+// ';' or '}', outside of any braces. start is where the failed declaration
+// began, it is skipped even if it looks like a place to start over.
+// False when the input runs out first.
+bool Parser::recoverDeclaration(uint32_t start) {
+    int depth = 0;
+    bool afterEnd = false;
+    while (!check(Type::END_OF_FILE)) {
+        const Token &token = currentToken();
+        Type t = token.getType();
+        if (depth == 0 && token.getSpan().offset != start &&
+            (t == Type::FUNCTION || t == Type::PROCEDURE || (afterEnd && inSet(DATATYPE_TYPES, t)))) {
+            return true;
+        }
+        if (t == Type::L_BRACE) {
+            depth++;
+        } else if (t == Type::R_BRACE && depth > 0) {
+            depth--;
+        }
+        afterEnd = depth == 0 && (t == Type::SEMICOLON || t == Type::R_BRACE);
+        advance();
+    }
+    return false;
+}
+
+const Token& Parser::peekNext() {
     return m_tokens.peekNext();
 }
 
 Node* Parser::createNodeFromToken(const Token &token) {
     //cout << "[DEBUG] Creating node: " << token.getText() << " at line " << token.getLine() << std::endl;
-    return new Node(token.getText(), token.getLine());
+    return m_arena.make<Node>(token.getText(), token.getSpan(), token.getNameId(), token.getLiteral());
 }
 
 Node* Parser::match(Type expected) {
     if (currentToken().getType() != expected) {
         error("Expected token of type " + tokenTypeToString(expected) +
-              ", but got " + currentToken().getTypeName() +
+              ", but got " + string(currentToken().getTypeName()) +
               " on line " + std::to_string(currentToken().getLine()));
     }
     Node* node = createNodeFromToken(currentToken());
@@ -53,137 +124,43 @@ bool Parser::check(Type expected) {
     return currentToken().getType() == expected;
 }
 
-bool Parser::checkAny(const vector<Type> &types) {
-    for (Type t : types) {
-        if (currentToken().getType() == t) {
-            return true;
-        }
-    }
-    return false;
-}
-
-void Parser::attachNodes(Node *parent, const vector<Node *> &children) {
-    //std::cout << "[DEBUG] Attaching children to: " << parent->name << std::endl;
-    if (children.empty()) {
-        return;
-    }
-    parent->leftChild = children[0];
-    Node* current = children[0];
-    for (int i = 1; i < children.size(); i++) {
-        if (current == children[i]) {
-            std::cerr << "[ERROR] Circular reference while attaching children to "
-                      << parent->name << "\n";
-            exit(1);
-        }
-        current->rightSibling = children[i];
-        current = current->rightSibling;
-    }
+bool Parser::checkAny(TypeSet types) {
+    return currentToken().isOneOf(types);
 }
 
-Node* Parser::buildNode(const string &label, const vector<Node *> &children) {
-    int line = children.empty() ? currentToken().getLine() : children[0]->lineNumber;
-    //std::cout << "[DEBUG] buildNode: " << label << " with " << children.size() << " children\n";
-    // Detect if any child is null
-    for (Node* child : children) {
-        if (!child) {
-            std::cerr << "[ERROR] Null child passed to buildNode for: " << label << "\n";
-            exit(1);
-        }
+Node* Parser::buildNode(string_view label, const ChildList &children) {
+    if (children.hasNull()) {
+        std::cerr << "[ERROR] Null child passed to buildNode for: " << label << "\n";
+        exit(1);
     }
-    // Detect if same pointer appears twice
-    for (int i = 0; i < children.size(); ++i) {
-        for (int j = i + 1; j < children.size(); ++j) {
-            if (children[i] == children[j]) {
-                std::cerr << "[ERROR] Duplicate child pointer detected in buildNode: " << label << "\n";
-                exit(1);
-            }
-        }
+    // Spans from the first child through the last, an empty node sits at the current token
+    SourceSpan span;
+    if (children.empty()) {
+        span = currentToken().getSpan();
+        span.length = 0;
+    } else {
+        span = children.front()->span.through(children.back()->span);
     }
-    Node* node = new Node(label, line);
-    //std::cout << "[DEBUG] Created node [" << label << "] with ID: " << node->id << "\n";
-    attachNodes(node, children);
+    //std::cout << "[DEBUG] buildNode: " << label << "\n";
+    // The children are already linked to each other
+    Node* node = m_arena.make<Node>(label, span);
+    node->leftChild = children.front();
     return node;
 }
 
 string Parser::tokenTypeToString(Type type) {
-    switch (type) {
-        case Type::IDENTIFIER:         return "IDENTIFIER";
-        case Type::INTEGER:            return "INTEGER";
-        case Type::STRING:             return "STRING";
-        case Type::DOUBLE_QUOTE:       return "DOUBLE_QUOTE";
-        case Type::SINGLE_QUOTE:       return "SINGLE_QUOTE";
-        case Type::RETURN_KEYWORD:     return "IDENTIFIER";
-        case Type::BOOLEAN_TRUE:       return "IDENTIFIER";
-        case Type::BOOLEAN_FALSE:      return "IDENTIFIER";
-        case Type::BOOLEAN_NOT:        return "BOOLEAN_NOT";
-        case Type::BOOLEAN_EQUAL:      return "BOOLEAN_EQUAL";
-        case Type::BOOLEAN_NOT_EQUAL:  return "BOOLEAN_NOT_EQUAL";
-        case Type::BOOLEAN_AND:        return "BOOLEAN_AND";
-        case Type::BOOLEAN_OR:         return "BOOLEAN_OR";
-        case Type::ASSIGNMENT_OPERATOR:return "ASSIGNMENT_OPERATOR";
-        case Type::PLUS:               return "PLUS";
-        case Type::MINUS:              return "MINUS";
-        case Type::ASTERISK:           return "ASTERISK";
-        case Type::DIVIDE:             return "DIVIDE";
-        case Type::MODULO:             return "MODULO";
-        case Type::LT_EQUAL:           return "LT_EQUAL";
-        case Type::GT_EQUAL:           return "GT_EQUAL";
-        case Type::LT:                 return "LT";
-        case Type::GT:                 return "GT";
-        case Type::SEMICOLON:          return "SEMICOLON";
-        case Type::COMMA:              return "COMMA";
-        case Type::INT:                return "INT";
-        case Type::BOOL:               return "BOOL";
-        case Type::CHAR:               return "CHAR";
-        case Type::GETCHAR:            return "GETCHAR";
-        case Type::VOID:                return "VOID";
-        case Type::IF:                 return "IF";
-        case Type::ELSE:                return "ELSE";
-        case Type::WHILE:              return "WHILE";
-        case Type::FOR:                return "FOR";
-        case Type::PRINTF:             return "PRINTF";
-        case Type::FUNCTION:           return "FUNCTION";
-        case Type::CARET:               return "CARET";
-        case Type::SIZEOF:              return "SIZEOF";
-        case Type::PROCEDURE:           return "PROCEDURE";
-        case Type::L_PAREN:            return "L_PAREN";
-        case Type::R_PAREN:            return "R_PAREN";
-        case Type::L_BRACE:            return "L_BRACE";
-        case Type::R_BRACE:            return "R_BRACE";
-        case Type::L_BRACKET:          return "L_BRACKET";
-        case Type::R_BRACKET:          return "R_BRACKET";
-        case Type::DOUBLE_QUOTED_STRING:return "DOUBLE_QUOTED_STRING";
-        case Type::SINGLE_QUOTED_STRING:return "SINGLE_QUOTED_STRING";
-        case Type::END_OF_FILE:        return "END_OF_FILE";
-        // Error states
-        case Type::ERROR_INVALID_INT:       return "ERROR_INVALID_INT";
-        case Type::ERROR_INVALID_CHAR:      return "ERROR_INVALID_CHAR";
-        case Type::ERROR_INVALID_OPERATOR:  return "ERROR_INVALID_OPERATOR";
-        case Type::ERROR_UNCLOSED_STRING:   return "ERROR_UNCLOSED_STRING";
-        case Type::ERROR_UNCLOSED_CHAR:     return "ERROR_UNCLOSED_CHAR";
-        case Type::ERROR_INVALID_IDENTIFIER:return "ERROR_INVALID_IDENTIFIER";
-        default:
-            return "UNKNOWN_TOKEN_TYPE";
-    }
+    return string(Token::typeName(type));
 }
 
-Token Parser::getLookahead(int n) {
-    TokenNode *cur = m_tokens.getHead();
-    while(n > 0 && cur != nullptr) {
-        cur = cur->next; n--;
-    }
-    if (cur != nullptr) {
-        return cur->token;
-    }
-    return Token(Type::END_OF_FILE, "", -1);
+const Token& Parser::getLookahead(int n) {
+    return m_tokens.peek(n);
 }
 
 // <DATATYPE_SPECIFIER> ::= char | bool | int
 Node* Parser::parseDATATYPE_SPECIFIER() {
-    vector<Type> validTypes = { Type::CHAR, Type::BOOL, Type::INT };
-    if (!checkAny(validTypes)) {
+    if (!checkAny(DATATYPE_TYPES)) {
         error("Expected datatype specifier (char, bool, int), but got: " +
-              currentToken().getText() + " on line " +
+              string(currentToken().getText()) + " on line " +
               std::to_string(currentToken().getLine()));
     }
     return match(currentToken().getType());
@@ -214,23 +191,22 @@ Node* Parser::parseSINGLE_QUOTED_STRING() {
 }
 
 Node* Parser::parseIDENTIFIER() {
+    // A copy, looking ahead may move the token window
     Token tok = currentToken();
-    std::string text = tok.getText();
+    std::string_view text = tok.getText();
     Type type = tok.getType();
-    // Check for reserved word
-    if (text == "char" || text == "bool" || text == "int" ||
-        text == "return" || text == "void" || text == "printf" ||
-        text == "getchar" || text == "sizeof" || text == "function" || text == "procedure" ||
-        text == "if" || text == "else" || text == "while" || text == "for") {
+    // Check for reserved word (TRUE and FALSE are reported as non-identifiers below)
+    Type reserved = lookupKeyword(text);
+    if (reserved != Type::IDENTIFIER && reserved != Type::BOOLEAN_TRUE && reserved != Type::BOOLEAN_FALSE) {
             std::string role = "variable";
             if (peekNext().getType() == Type::L_PAREN) {
                 role = "function";
             }
         error("Syntax error on line " + std::to_string(tok.getLine()) +
-              ": reserved word \"" + text + "\" cannot be used for the name of a " + role + ".");
+              ": reserved word \"" + string(text) + "\" cannot be used for the name of a " + role + ".");
         }
     if (type != Type::IDENTIFIER) {
-        error("Expected identifier, but got \"" + text + "\" on line " +
+        error("Expected identifier, but got \"" + string(text) + "\" on line " +
               std::to_string(tok.getLine()));
     }
     return match(Type::IDENTIFIER);
@@ -238,7 +214,7 @@ Node* Parser::parseIDENTIFIER() {
 
 // <IDENTIFIER_LIST> ::= <IDENTIFIER> | <IDENTIFIER> <COMMA> <IDENTIFIER_LIST>
 Node* Parser::parseIDENTIFIER_LIST() {
-    std::vector<Node*> children;
+    ChildList children;
     // <IDENTIFIER>
     children.push_back(parseIDENTIFIER());
     // if <COMMA>, expect <IDENTIFIER_LIST>
@@ -252,7 +228,7 @@ Node* Parser::parseIDENTIFIER_LIST() {
 }
 
 Node* Parser::parseIDENTIFIER_ARRAY_LIST() {
-    std::vector<Node*> children;
+    ChildList children;
     // <IDENTIFIER> <L_BRACKET> <WHOLE_NUMBER> <R_BRACKET>
     children.push_back(parseIDENTIFIER());
     children.push_back(match(Type::L_BRACKET));
@@ -262,7 +238,7 @@ Node* Parser::parseIDENTIFIER_ARRAY_LIST() {
     }
     // make sure integer is positive
     Token numberToken = currentToken();
-    int value = stoi(numberToken.getText());
+    int value = literalPool().get(numberToken.getLiteral()).value;
     if (value <= 0) {
         error("Syntax error on line " + std::to_string(numberToken.getLine()) +
               ": array declaration size must be a positive integer.");
@@ -284,7 +260,7 @@ Node* Parser::parseIDENTIFIER_ARRAY_LIST() {
  * <IDENTIFIER_ARRAY_LIST> <IDENTIFIER_LIST>
 */
 Node* Parser::parseIDENTIFIER_AND_IDENTIFIER_ARRAY_LIST() {
-    std::vector<Node*> children;
+    ChildList children;
     // <IDENTIFIER_LIST> | <IDENTIFIER_ARRAY_LIST>
     if (check(Type::IDENTIFIER)) {
         // Peek to determine if this is part of an array or just an identifier
@@ -316,7 +292,7 @@ Node* Parser::parseIDENTIFIER_AND_IDENTIFIER_ARRAY_LIST() {
 
 // <IDENTIFIER_AND_IDENTIFIER_ARRAY_PARAMETER_LIST> ::= ...
 Node* Parser::parseIDENTIFIER_AND_IDENTIFIER_ARRAY_PARAMETER_LIST() {
-    std::vector<Node*> children;
+    ChildList children;
     // <IDENTIFIER>
     Node* id = parseIDENTIFIER();
     children.push_back(id);
@@ -340,7 +316,7 @@ Node* Parser::parseIDENTIFIER_AND_IDENTIFIER_ARRAY_PARAMETER_LIST() {
 }
 
 Node* Parser::parseIDENTIFIER_AND_IDENTIFIER_ARRAY_PARAMETER_LIST_DECLARATION() {
-    std::vector<Node*> children;
+    ChildList children;
     // <IDENTIFIER>
     Node* id = parseIDENTIFIER();
     children.push_back(id);
@@ -366,9 +342,9 @@ Node* Parser::parseIDENTIFIER_AND_IDENTIFIER_ARRAY_PARAMETER_LIST_DECLARATION()
 
 // <BOOLEAN_OPERATOR> ::= <BOOLEAN_AND> | <BOOLEAN_OR>
 Node* Parser::parseBOOLEAN_OPERATOR() {
-    if (!checkAny({ Type::BOOLEAN_AND, Type::BOOLEAN_OR })) {
+    if (!checkAny(BOOLEAN_OPERATOR_TYPES)) {
         error("Expected boolean operator (&& or ||), but got '" +
-              currentToken().getText() + "' on line " +
+              string(currentToken().getText()) + "' on line " +
               std::to_string(currentToken().getLine()));
     }
     return match(currentToken().getType());
@@ -376,7 +352,7 @@ Node* Parser::parseBOOLEAN_OPERATOR() {
 
 // <GETCHAR_FUNCTION> ::= getchar <L_PAREN> <IDENTIFIER> <R_PAREN>
 Node* Parser::parseGETCHAR_FUNCTION() {
-    std::vector<Node*> children;
+    ChildList children;
     children.push_back(match(Type::GETCHAR));
     children.push_back(match(Type::L_PAREN));
     if (currentToken().getType() != Type::VOID) {
@@ -389,7 +365,7 @@ Node* Parser::parseGETCHAR_FUNCTION() {
 }
 
 Node* Parser::parseSIZEOF_FUNCTION() {
-    std::vector<Node*> children;
+    ChildList children;
     children.push_back(match(Type::SIZEOF));
     children.push_back(match(Type::L_PAREN));
     children.push_back(parseIDENTIFIER());
@@ -399,41 +375,25 @@ Node* Parser::parseSIZEOF_FUNCTION() {
 
 // <NUMERICAL_OPERATOR> ::= <PLUS> | <MINUS> | <ASTERISK> | <DIVIDE> | <MODULO> | <CARET>
 Node* Parser::parseNUMERICAL_OPERATOR() {
-    vector<Type> validOperators = {
-        Type::PLUS,
-        Type::MINUS,
-        Type::ASTERISK,
-        Type::DIVIDE,
-        Type::MODULO,
-        Type::CARET
-    };
-    if (!checkAny(validOperators)) {
+    if (!checkAny(NUMERICAL_OPERATOR_TYPES)) {
         error("Expected numerical operator (+, -, *, /, %, ^) but got '" +
-              currentToken().getText() + "' on line " +
+              string(currentToken().getText()) + "' on line " +
               std::to_string(currentToken().getLine()));
     }
     return match(currentToken().getType());
 }
 
 Node* Parser::parseRELATIONAL_EXPRESSION() {
-    std::vector<Type> relationalTypes = {
-        Type::LT,
-        Type::LT_EQUAL,
-        Type::GT,
-        Type::GT_EQUAL,
-        Type::BOOLEAN_EQUAL,
-        Type::BOOLEAN_NOT_EQUAL
-    };
-    if (!checkAny(relationalTypes)) {
+    if (!checkAny(RELATIONAL_OPERATOR_TYPES)) {
         error("Expected relational operator (<, <=, >, >=, ==, !=) but got '" +
-              currentToken().getText() + "' on line " +
+              string(currentToken().getText()) + "' on line " +
               std::to_string(currentToken().getLine()));
     }
     return match(currentToken().getType());
 }
 
 Node* Parser::parseNUMERICAL_EXPRESSION() {
-    if (checkAny({ Type::PLUS, Type::MINUS, Type::ASTERISK, Type::DIVIDE, Type::MODULO, Type::CARET })) {
+    if (checkAny(NUMERICAL_OPERATOR_TYPES)) {
         Node* unaryOp = parseNUMERICAL_OPERATOR();
         //cout << "[DEBUG] Consumed NUMERICAL_OPERATOR (unary)" << endl;
         Node* expr = parseNUMERICAL_EXPRESSION();
@@ -460,7 +420,7 @@ Node* Parser::parseNUMERICAL_EXPRESSION() {
             Node* rparen = match(Type::R_PAREN);
             return buildNode("NUMERICAL_EXPRESSION", { lparen, operand, rparen });
         }
-        if (checkAny({ Type::PLUS, Type::MINUS, Type::ASTERISK, Type::DIVIDE, Type::MODULO, Type::CARET })) {
+        if (checkAny(NUMERICAL_OPERATOR_TYPES)) {
             Node* op = parseNUMERICAL_OPERATOR();
             //cout << "[DEBUG] Consumed NUMERICAL_OPERATOR" << endl;
             //cout << "[DEBUG] Moving to numerical expression" << endl;
@@ -468,7 +428,7 @@ Node* Parser::parseNUMERICAL_EXPRESSION() {
             if (check(Type::R_PAREN)) {
                 Node* rparen = match(Type::R_PAREN);
                 //cout << "[DEBUG] Consumed R_PAREN" << endl;
-                if (checkAny({ Type::PLUS, Type::MINUS, Type::ASTERISK, Type::DIVIDE, Type::MODULO, Type::CARET })) {
+                if (checkAny(NUMERICAL_OPERATOR_TYPES)) {
                     Node* op2 = parseNUMERICAL_OPERATOR();
                     //cout << "[DEBUG] Consumed NUMERICAL_OPERATOR" << endl;
                     Node* expr2 = parseNUMERICAL_EXPRESSION();
@@ -479,7 +439,7 @@ Node* Parser::parseNUMERICAL_EXPRESSION() {
         }
     }
     Node* operand = parseNUMERICAL_OPERAND();
-    if (!checkAny({ Type::PLUS, Type::MINUS, Type::ASTERISK, Type::DIVIDE, Type::MODULO, Type::CARET })) {
+    if (!checkAny(NUMERICAL_OPERATOR_TYPES)) {
         return buildNode("NUMERICAL_EXPRESSION", { operand });
     }
     Node* op = parseNUMERICAL_OPERATOR();
@@ -492,7 +452,7 @@ Node* Parser::parseNUMERICAL_EXPRESSION() {
         }
         Node* rparen = match(Type::R_PAREN);
         Node* parenExpr = buildNode("NUMERICAL_EXPRESSION", { lparen, innerExpr, rparen });
-        if (checkAny({ Type::PLUS, Type::MINUS, Type::ASTERISK, Type::DIVIDE, Type::MODULO, Type::CARET })) {
+        if (checkAny(NUMERICAL_OPERATOR_TYPES)) {
             Node* op2 = parseNUMERICAL_OPERATOR();
             Node* expr2 = parseNUMERICAL_EXPRESSION();
             return buildNode("NUMERICAL_EXPRESSION", { operand, op, parenExpr, op2, expr2 });
@@ -505,14 +465,9 @@ Node* Parser::parseNUMERICAL_EXPRESSION() {
 }
 
 Node* Parser::parseBOOLEAN_EXPRESSION() {
-    if ((getLookahead(1).getType() == Type::BOOLEAN_EQUAL ||
-        getLookahead(1).getType() == Type::LT_EQUAL ||
-        getLookahead(1).getType() == Type::GT_EQUAL ||
-        getLookahead(1).getType() == Type::LT ||
-        getLookahead(1).getType() == Type::GT) ||
-        (currentToken().getType() == Type::L_PAREN && getLookahead(1).getType() == Type::IDENTIFIER && (getLookahead(2).getType() == Type::PLUS ||
-            getLookahead(2).getType() == Type::MINUS || getLookahead(2).getType() == Type::ASTERISK || getLookahead(2).getType() == Type::DIVIDE ||
-            getLookahead(2).getType() == Type::MODULO))) {
+    if (getLookahead(1).isOneOf(COMPARISON_LOOKAHEAD) ||
+        (currentToken().getType() == Type::L_PAREN && getLookahead(1).getType() == Type::IDENTIFIER &&
+         getLookahead(2).isOneOf(ARITHMETIC_LOOKAHEAD))) {
         Node* leftNumExpr = parseNUMERICAL_EXPRESSION(); Node* relOp = match(currentToken().getType());
         //cout << "[DEBUG] Consumed RELATIONAL_OPERATOR" << endl;
         Node* rightNumExpr = parseNUMERICAL_EXPRESSION();
@@ -530,8 +485,7 @@ Node* Parser::parseBOOLEAN_EXPRESSION() {
     }
     if (currentToken().getType() == Type::L_PAREN &&
         getLookahead(1).getType() == Type::IDENTIFIER &&
-        (getLookahead(2).getType() == Type::BOOLEAN_AND ||
-         getLookahead(2).getType() == Type::BOOLEAN_OR)) {
+        getLookahead(2).isOneOf(BOOLEAN_OPERATOR_TYPES)) {
         Node* lparen = match(Type::L_PAREN);
         //cout << "[DEBUG] Consumed L_PAREN" << endl;
         Node* idNode = parseIDENTIFIER();
@@ -554,13 +508,12 @@ Node* Parser::parseBOOLEAN_EXPRESSION() {
             return buildNode("BOOLEAN_EXPRESSION", { lparen, notNode, operand, rparen });
         } else {
             Node* operand = parseNUMERICAL_OPERAND();
-            if (checkAny({Type::BOOLEAN_EQUAL, Type::BOOLEAN_NOT_EQUAL,
-                          Type::LT_EQUAL, Type::GT_EQUAL, Type::LT, Type::GT})) {
+            if (checkAny(RELATIONAL_OPERATOR_TYPES)) {
                 Node* relOp = parseRELATIONAL_EXPRESSION();
                 Node* operand2 = parseNUMERICAL_OPERAND();
                 Node* rparen = match(Type::R_PAREN);
-                vector<Node*> group = { lparen, operand, relOp, operand2, rparen };
-                if (checkAny({Type::BOOLEAN_AND, Type::BOOLEAN_OR})) {
+                ChildList group = { lparen, operand, relOp, operand2, rparen };
+                if (checkAny(BOOLEAN_OPERATOR_TYPES)) {
                     Node* boolOp = parseBOOLEAN_OPERATOR();
                     Node* rest = parseBOOLEAN_EXPRESSION();
                     group.push_back(boolOp);
@@ -587,7 +540,7 @@ Node* Parser::parseBOOLEAN_EXPRESSION() {
     }
     if (currentToken().isIdentifier()) {
         Node* id = parseIDENTIFIER();
-        if (checkAny({Type::BOOLEAN_AND, Type::BOOLEAN_OR})) {
+        if (checkAny(BOOLEAN_OPERATOR_TYPES)) {
             Node* boolOp = parseBOOLEAN_OPERATOR();
             Node* rest = parseBOOLEAN_EXPRESSION();
             return buildNode("BOOLEAN_EXPRESSION", { id, boolOp, rest });
@@ -600,13 +553,12 @@ Node* Parser::parseBOOLEAN_EXPRESSION() {
 }
 
 bool Parser::isBooleanExpression() {
-    TokenNode* cur = m_tokens.getHead();
     int parenDepth = 0;
-    while (cur != nullptr) {
-        Type type = cur->token.getType();
+    // Pulls only as far as the expression goes
+    for (size_t i = 0; !m_tokens.peek(i).isEndOfFile(); i++) {
+        Type type = m_tokens.peek(i).getType();
         // break on delimiter if not in parenthesis
-        if (parenDepth == 0 && (type == Type::SEMICOLON || type == Type::COMMA ||
-            type == Type::R_PAREN || type == Type::R_BRACKET || type == Type::R_BRACE)) {
+        if (parenDepth == 0 && inSet(EXPRESSION_END, type)) {
             break;
             }
         if (type == Type::L_PAREN) {
@@ -618,13 +570,9 @@ bool Parser::isBooleanExpression() {
                 break;
         }
         // Check for boolean operators or relational
-        if (type == Type::BOOLEAN_AND || type == Type::BOOLEAN_OR || type == Type::BOOLEAN_NOT ||
-            type == Type::BOOLEAN_TRUE || type == Type::BOOLEAN_FALSE ||
-            type == Type::BOOLEAN_EQUAL || type == Type::BOOLEAN_NOT_EQUAL ||
-            type == Type::LT || type == Type::GT || type == Type::LT_EQUAL || type == Type::GT_EQUAL) {
+        if (inSet(BOOLEAN_MARKERS, type)) {
             return true;
             }
-        cur = cur->next;
     }
     return false;
 }
@@ -640,7 +588,7 @@ Node* Parser::parseEXPRESSION() {
 }
 
 Node* Parser::parseUSER_DEFINED_FUNCTION() {
-    std::vector<Node*> children;
+    ChildList children;
     Node* id = parseIDENTIFIER();
     children.push_back(id);
     children.push_back(match(Type::L_PAREN));
@@ -661,7 +609,7 @@ Node* Parser::parseUSER_DEFINED_FUNCTION() {
 }
 
 Node* Parser::parseUSER_DEFINED_PROCEDURE_CALL_STATEMENT() {
-    std::vector<Node*> children;
+    ChildList children;
     Node* id = parseIDENTIFIER();
     children.push_back(id);
     children.push_back(match(Type::L_PAREN));
@@ -680,7 +628,7 @@ Node* Parser::parseUSER_DEFINED_PROCEDURE_CALL_STATEMENT() {
 }
 
 Node* Parser::parseNUMERICAL_OPERAND() {
-    std::vector<Node*> children;
+    ChildList children;
     // <INTEGER>
     if (check(Type::INTEGER)) {
         children.push_back(match(Type::INTEGER));
@@ -729,7 +677,7 @@ Node* Parser::parseNUMERICAL_OPERAND() {
 }
 
 Node* Parser::parseINITIALIZATION_EXPRESSION() {
-    std::vector<Node*> children;
+    ChildList children;
     //std::cout << "[DEBUG] Entering parseINITIALIZATION_EXPRESSION()\n";
     Node* id = parseIDENTIFIER();
     children.push_back(id);
@@ -757,7 +705,7 @@ Node* Parser::parseINITIALIZATION_EXPRESSION() {
 }
 
 Node* Parser::parseITERATION_ASSIGNMENT() {
-    std::vector<Node*> children;
+    ChildList children;
     // <IDENTIFIER>
     children.push_back(parseIDENTIFIER());
     // <ASSIGNMENT_OPERATOR>
@@ -797,8 +745,8 @@ Node* Parser::parseASSIGNMENT_STATEMENT() {
         return buildNode("AssignmentStatement", { initExpr, semi });
     }
     //std::cout << "[DEBUG] Detected array assignment\n";
-    std::vector<Node*> assignChildren;
-    std::vector<Node*> arrayChildren;
+    ChildList assignChildren;
+    ChildList arrayChildren;
     arrayChildren.push_back(parseIDENTIFIER());
     //std::cout << "[DEBUG] Parsed array identifier: " << arrayChildren.back()->name << "\n";
     arrayChildren.push_back(match(Type::L_BRACKET));
@@ -837,7 +785,7 @@ Node* Parser::parseASSIGNMENT_STATEMENT() {
 
 
 Node* Parser::parseDECLARATION_STATEMENT() {
-    vector<Node*> children;
+    ChildList children;
     Node* dtype = parseDATATYPE_SPECIFIER();
     children.push_back(dtype);
     Node* idOrList = nullptr;
@@ -852,7 +800,7 @@ Node* Parser::parseDECLARATION_STATEMENT() {
 }
 
 Node* Parser::parseRETURN_STATEMENT() {
-    std::vector<Node*> children;
+    ChildList children;
     children.push_back(match(Type::RETURN_KEYWORD));
     if (check(Type::SINGLE_QUOTE)) {
         children.push_back(parseSINGLE_QUOTED_STRING());
@@ -866,7 +814,7 @@ Node* Parser::parseRETURN_STATEMENT() {
 }
 
 Node* Parser::parseSELECTION_STATEMENT() {
-    std::vector<Node*> children;
+    ChildList children;
     // if
     children.push_back(match(Type::IF));
     // (
@@ -897,7 +845,7 @@ Node* Parser::parseSELECTION_STATEMENT() {
 }
 
 Node* Parser::parsePRINTF_STATEMENT() {
-    std::vector<Node*> children;
+    ChildList children;
     children.push_back(match(Type::PRINTF));
     children.push_back(match(Type::L_PAREN));
     Node* formatString = nullptr;
@@ -919,18 +867,11 @@ Node* Parser::parsePRINTF_STATEMENT() {
 }
 
 bool Parser::startsStatement(Type t) {
-    return t == Type::IF ||
-           t == Type::WHILE ||
-               t == Type::FOR ||
-           t == Type::RETURN_KEYWORD ||
-           t == Type::PRINTF ||
-           t == Type::IDENTIFIER ||
-           t == Type::CHAR || t == Type::INT || t == Type::BOOL ||
-           t == Type::L_BRACE;
+    return inSet(FIRST_STATEMENT, t);
 }
 
 /*Node* Parser::parseCOMPOUND_STATEMENT() {
-    std::vector<Node*> children;
+    ChildList children;
     // <STATEMENT>
     children.push_back(parseSTATEMENT());
     // if <STATEMENT>, then compound statement
@@ -941,18 +882,19 @@ bool Parser::startsStatement(Type t) {
 }*/
 
 Node* Parser::parseCOMPOUND_STATEMENT() {
-    std::vector<Node*> children;
-    if (startsStatement(currentToken().getType())) {
-        children.push_back(parseSTATEMENT());
-        while (startsStatement(currentToken().getType())) {
+    ChildList children;
+    while (startsStatement(currentToken().getType())) {
+        try {
             children.push_back(parseSTATEMENT());
+        } catch (const ParseError &) {
+            recoverStatement();
         }
     }
     return buildNode("CompoundStatement", children);
 }
 
 Node* Parser::parseBLOCK_STATEMENT() {
-    std::vector<Node*> children;
+    ChildList children;
     children.push_back(match(Type::L_BRACE));
     children.push_back(parseCOMPOUND_STATEMENT());
     children.push_back(match(Type::R_BRACE));
@@ -960,8 +902,8 @@ Node* Parser::parseBLOCK_STATEMENT() {
 }
 
 Node* Parser::parseITERATION_STATEMENT() {
-    std::vector<Node*> children;
-    std::string keyword = currentToken().getText();
+    ChildList children;
+    std::string_view keyword = currentToken().getText();
     if (keyword == "for") {
         // for <L_PAREN> <INITIALIZATION_EXPRESSION> <SEMICOLON> <BOOLEAN_EXPRESSION> <SEMICOLON> <ITERATION_ASSIGNMENT> <R_PAREN> <STATEMENT/BLOCK_STATEMENT>
         children.push_back(match(Type::FOR));
@@ -1000,7 +942,7 @@ Node* Parser::parseITERATION_STATEMENT() {
 
 Node* Parser::parseSTATEMENT() {
     Type t = currentToken().getType();
-    if (t == Type::CHAR || t == Type::BOOL || t == Type::INT) {
+    if (inSet(DATATYPE_TYPES, t)) {
         return parseDECLARATION_STATEMENT();
     }
     if (t == Type::RETURN_KEYWORD) {
@@ -1023,15 +965,15 @@ Node* Parser::parseSTATEMENT() {
         if (next.getType() == Type::ASSIGNMENT_OPERATOR || next.getType() == Type::L_BRACKET) {
             return parseASSIGNMENT_STATEMENT();
         }
-        error("Unrecognized statement starting with identifier: " + currentToken().getText());
+        error("Unrecognized statement starting with identifier: " + string(currentToken().getText()));
     }
-    error("Unexpected token in statement: " + currentToken().getText() +
+    error("Unexpected token in statement: " + string(currentToken().getText()) +
           " on line " + std::to_string(currentToken().getLine()));
     return nullptr;
 }
 
 Node* Parser::parsePARAMETER_LIST() {
-    std::vector<Node*> children;
+    ChildList children;
     children.push_back(parseDATATYPE_SPECIFIER());
     Token next = peekNext();
     if (next.getType() == Type::COMMA) {
@@ -1059,7 +1001,7 @@ Node* Parser::parsePARAMETER_LIST() {
 }
 
 Node* Parser::parseFUNCTION_DECLARATION() {
-    std::vector<Node*> children;
+    ChildList children;
     // function keyword
     children.push_back(match(Type::FUNCTION));
     // return type
@@ -1085,7 +1027,7 @@ Node* Parser::parseFUNCTION_DECLARATION() {
 }
 
 Node* Parser::parsePROCEDURE_DECLARATION() {
-    std::vector<Node*> children;
+    ChildList children;
     // procedure
     children.push_back(match(Type::PROCEDURE));
     // <IDENTIFIER>
@@ -1109,7 +1051,7 @@ Node* Parser::parsePROCEDURE_DECLARATION() {
 }
 
 Node* Parser::parseMAIN_PROCEDURE() {
-    std::vector<Node*> children;
+    ChildList children;
     children.push_back(match(Type::PROCEDURE));
     if (currentToken().getType() != Type::IDENTIFIER || currentToken().getText() != "main") {
         error("Expected 'main' identifier after 'procedure' on line " +
@@ -1124,59 +1066,75 @@ Node* Parser::parseMAIN_PROCEDURE() {
 }
 
 Node* Parser::parsePROGRAM_TAIL() {
-    std::vector<Node*> children;
+    ChildList children;
     while (true) {
         Type t = currentToken().getType();
-        if (t == Type::FUNCTION) {
-            children.push_back(parseFUNCTION_DECLARATION());
-        }
-        else if (t == Type::PROCEDURE) {
-            Token next = peekNext();
-            if (next.getType() == Type::IDENTIFIER && next.getText() == "main") {
+        uint32_t start = currentToken().getSpan().offset;
+        try {
+            if (t == Type::FUNCTION) {
+                children.push_back(parseFUNCTION_DECLARATION());
+            }
+            else if (t == Type::PROCEDURE) {
+                Token next = peekNext();
+                if (next.getType() == Type::IDENTIFIER && next.getText() == "main") {
+                    break;
+                }
+                children.push_back(parsePROCEDURE_DECLARATION());
+            }
+            else if (inSet(DATATYPE_TYPES, t)) {
+                children.push_back(parseDECLARATION_STATEMENT());
+            }
+            else {
+                break;
+            }
+        } catch (const ParseError &) {
+            if (!recoverDeclaration(start)) {
                 break;
             }
-            children.push_back(parsePROCEDURE_DECLARATION());
-        }
-        else if (t == Type::CHAR || t == Type::BOOL || t == Type::INT) {
-            children.push_back(parseDECLARATION_STATEMENT());
-        }
-        else {
-            break;
         }
     }
     return buildNode("ProgramTail", children);
 }
 
 Node* Parser::parsePROGRAM() {
-    std::vector<Node*> children;
+    ChildList children;
     Type t = currentToken().getType();
-    if (t == Type::PROCEDURE) {
-        Token next = peekNext();
-        if (next.getType() == Type::IDENTIFIER && next.getText() == "main") {
+    uint32_t start = currentToken().getSpan().offset;
+    bool isMain = t == Type::PROCEDURE && peekNext().getType() == Type::IDENTIFIER &&
+                  peekNext().getText() == "main";
+    try {
+        if (isMain) {
             children.push_back(parseMAIN_PROCEDURE());
             if (!check(Type::END_OF_FILE)) {
                 children.push_back(parsePROGRAM_TAIL());
             }
             return buildNode("Program", children);
         }
-        children.push_back(parsePROCEDURE_DECLARATION());
-        children.push_back(parsePROGRAM());
-        return buildNode("Program", children);
-    }
-    if (t == Type::FUNCTION) {
-        children.push_back(parseFUNCTION_DECLARATION());
-        children.push_back(parsePROGRAM());
-        return buildNode("Program", children);
-    }
-    if (t == Type::CHAR || t == Type::BOOL || t == Type::INT) {
-        children.push_back(parseDECLARATION_STATEMENT());
-        children.push_back(parsePROGRAM());
-        return buildNode("Program", children);
-    }
-    error("Unexpected token '" + currentToken().getText() +
-          "' at line " + std::to_string(currentToken().getLine()) +
-          ". Expected function, procedure, declaration, or main procedure.");
-    return nullptr;
+        if (t == Type::PROCEDURE) {
+            children.push_back(parsePROCEDURE_DECLARATION());
+            children.push_back(parsePROGRAM());
+            return buildNode("Program", children);
+        }
+        if (t == Type::FUNCTION) {
+            children.push_back(parseFUNCTION_DECLARATION());
+            children.push_back(parsePROGRAM());
+            return buildNode("Program", children);
+        }
+        if (inSet(DATATYPE_TYPES, t)) {
+            children.push_back(parseDECLARATION_STATEMENT());
+            children.push_back(parsePROGRAM());
+            return buildNode("Program", children);
+        }
+        error("Unexpected token '" + string(currentToken().getText()) +
+              "' at line " + std::to_string(currentToken().getLine()) +
+              ". Expected function, procedure, declaration, or main procedure.");
+    } catch (const ParseError &) {
+        // Go on with the next declaration, what comes after main is its tail
+        if (!recoverDeclaration(start)) {
+            return buildNode("Program", ChildList{});
+        }
+        return isMain ? parsePROGRAM_TAIL() : parsePROGRAM();
+    }
 }
 
 //Output Functions:
@@ -1192,8 +1150,9 @@ void Parser::printTreeHelper(Node* node, std::string prefix, bool isLastChild) {
     std::cout << (isLastChild ? "+-- " : "|-- ");
     // Print node name and line number
     std::cout << node->name;
-    if (node->lineNumber > 0) {
-        std::cout << " (" << node->lineNumber << ")";
+    int line = node->span.line();
+    if (line > 0) {
+        std::cout << " (" << line << ")";
     }
     std::cout << std::endl;
     // Update branch prefix
@@ -1229,29 +1188,36 @@ void Parser::collectTerminalNodes(Node* node, vector<Node*>& terminals) {
 Node* Parser::makeTerminalOnlyCST(Node* parseTreeRoot) {
     vector<Node*> terminals;
     collectTerminalNodes(parseTreeRoot, terminals);
-    map<int, vector<Node*>> tokensByLine;
+    // Terminals come out in source order, so lines only need sorting if an
+    // empty node was placed out of order; the sort is stable either way
+    vector<pair<int, Node*>> byLine;
+    byLine.reserve(terminals.size());
     for (Node* token : terminals) {
-        Node* cloned = token->clone();
-        tokensByLine[token->lineNumber].push_back(cloned);
+        byLine.emplace_back(token->span.line(), token->clone(m_arena));
+    }
+    auto lineLess = [](const pair<int, Node*> &a, const pair<int, Node*> &b) { return a.first < b.first; };
+    if (!is_sorted(byLine.begin(), byLine.end(), lineLess)) {
+        stable_sort(byLine.begin(), byLine.end(), lineLess);
     }
+    // Terminals of a line become siblings, each line hangs under the last
+    // terminal of the line before
     Node* newRoot = nullptr;
     Node* prevLastToken = nullptr;
-    for (auto& [line, lineTokens] : tokensByLine) {
-        for (int i = 1; i < lineTokens.size(); ++i) {
-            lineTokens[i - 1]->rightSibling = lineTokens[i];
-        }
-        if (!lineTokens.empty()) {
-            lineTokens.back()->rightSibling = nullptr;
-        }
-        if (newRoot == nullptr && !lineTokens.empty()) {
-            newRoot = lineTokens[0];
+    for (size_t i = 0; i < byLine.size(); ) {
+        size_t lineEnd = i + 1;
+        while (lineEnd < byLine.size() && byLine[lineEnd].first == byLine[i].first) {
+            byLine[lineEnd - 1].second->rightSibling = byLine[lineEnd].second;
+            lineEnd++;
         }
-        if (prevLastToken && !lineTokens.empty()) {
-            prevLastToken->leftChild = lineTokens[0];
+        byLine[lineEnd - 1].second->rightSibling = nullptr;
+        if (newRoot == nullptr) {
+            newRoot = byLine[i].second;
         }
-        if (!lineTokens.empty()) {
-            prevLastToken = lineTokens.back();
+        if (prevLastToken) {
+            prevLastToken->leftChild = byLine[i].second;
         }
+        prevLastToken = byLine[lineEnd - 1].second;
+        i = lineEnd;
     }
     return newRoot;
 }
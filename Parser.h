@@ -9,12 +9,18 @@
 #include "Token.h"
 #include "TokenList.h"
 #include "Node.h"
+#include "Diagnostics.h"
 
 using namespace std;
 
+// Nodes are allocated in the parser's arena and all released with it, so
+// the parser has to outlive the trees it returns. Syntax errors go to the
+// diagnostics, parsing picks up again at the next statement or declaration
+// so that one run reports as many of them as it can; the tree returned is
+// only meaningful when none were reported.
 class Parser {
     public:
-    Parser(TokenList &tokens);
+    Parser(TokenList &tokens, Diagnostics &diagnostics);
     Node* parse();
 
     //Output Functions
@@ -25,18 +31,23 @@ class Parser {
 private:
     //Functions and Helpers for managing TokenList & Tree Node creation
     TokenList &m_tokens; // The TokenList we’re reading from
-    Token currentToken(); // get the current token without removing it
+    NodeArena m_arena; // Every node of this parse
+    Diagnostics &m_diagnostics;
+    // Thrown by error() and caught where parsing can resume
+    struct ParseError {};
+    const Token& currentToken(); // get the current token without removing it
     void advance(); // Advance to the next token
-    void error(const std::string &msg); // throw error and exit
-    Token peekNext();
+    [[noreturn]] void error(const std::string &msg); // report and unwind to the last recovery point
+    void recoverStatement();
+    bool recoverDeclaration(uint32_t start);
+    const Token& peekNext();
     Node* createNodeFromToken(const Token &token);
     Node* match(Type expected);
     bool check(Type expected);
-    bool checkAny(const vector<Type>& types);
-    void attachNodes(Node* parent, const vector<Node*>& children);
-    Node* buildNode(const string &label, const vector<Node*>& children);
+    bool checkAny(TypeSet types);
+    Node* buildNode(string_view label, const ChildList& children);
     string tokenTypeToString(Type type);
-    Token getLookahead(int n);
+    const Token& getLookahead(int n);
 
     // Each grammar rule as a function:
     Node *parseDATATYPE_SPECIFIER();
@@ -0,0 +1,48 @@
+/** ***************************************************************************
+ * @remark Read-only view of an input file, memory-mapped when possible so   *
+ *          the tokenizer can scan it through a pointer/length cursor.        *
+ *                                                                            *
+ * @file  SourceBuffer.cpp                                                    *
+ *****************************************************************************/
+
+#include "SourceBuffer.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceBuffer::SourceBuffer(const std::string &inputFile)
+    : _data(""), _size(0), _open(false), _mapped(false) {
+    int fd = open(inputFile.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    _open = true;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+            _data = static_cast<const char*>(mapped);
+            _size = info.st_size;
+            _mapped = true;
+            close(fd);
+            return;
+        }
+    }
+    // Fallback: read the whole input into memory
+    char block[1 << 16];
+    ssize_t n;
+    while ((n = read(fd, block, sizeof(block))) > 0) {
+        _fallback.append(block, n);
+    }
+    close(fd);
+    _data = _fallback.data();
+    _size = _fallback.size();
+}
+
+SourceBuffer::~SourceBuffer() {
+    if (_mapped) {
+        munmap(const_cast<char*>(_data), _size);
+    }
+}
@@ -0,0 +1,36 @@
+/** ***************************************************************************
+ * @remark Read-only view of an input file, memory-mapped when possible so   *
+ *          the tokenizer can scan it through a pointer/length cursor.        *
+ *                                                                            *
+ * @file  SourceBuffer.h                                                      *
+ *****************************************************************************/
+
+#ifndef SOURCEBUFFER_H
+#define SOURCEBUFFER_H
+
+#include <string>
+#include <cstddef>
+
+class SourceBuffer {
+public:
+    explicit SourceBuffer(const std::string &inputFile);
+    ~SourceBuffer();
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    bool isOpen() const { return _open; }
+    bool isMapped() const { return _mapped; }
+    const char* begin() const { return _data; }
+    const char* end() const { return _data + _size; }
+    size_t size() const { return _size; }
+
+private:
+    const char* _data;
+    size_t _size;
+    bool _open;
+    bool _mapped;
+    // Used when the file cannot be mapped (pipes, empty files, ...)
+    std::string _fallback;
+};
+
+#endif // SOURCEBUFFER_H
@@ -0,0 +1,69 @@
+/** ***************************************************************************
+ * @remark Source positions. Tokens and tree nodes keep byte spans; line    *
+ *          and column are looked up in a per-file index of line starts    *
+ *          that is built the first time a diagnostic or printer asks.     *
+ *                                                                            *
+ * @file  SourceMap.cpp                                                       *
+ *****************************************************************************/
+
+#include "SourceMap.h"
+#include "ByteScan.h"
+#include <algorithm>
+
+int SourceSpan::line() const {
+    return location().line;
+}
+
+LineColumn SourceSpan::location() const {
+    if (file == NO_FILE) {
+        return { static_cast<int>(offset), 0 };
+    }
+    return sourceMap().lines(file).locate(offset);
+}
+
+SourceSpan SourceSpan::through(const SourceSpan &last) const {
+    if (file != last.file || file == NO_FILE || last.offset + last.length < offset) {
+        return *this;
+    }
+    return { file, offset, last.offset + last.length - offset };
+}
+
+void LineIndex::setText(const char* begin, const char* end) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _begin = begin;
+    _end = end;
+    _lineStarts.assign(1, 0);
+}
+
+void LineIndex::appendText(const char* begin, const char* end, uint32_t offset) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    addLineStarts(begin, end, offset);
+}
+
+void LineIndex::addLineStarts(const char* begin, const char* end, uint32_t offset) {
+    // Count first so the starts are stored without regrowing
+    _lineStarts.reserve(_lineStarts.size() + countByte(begin, end, '\n'));
+    for (const char* cur = begin; (cur = scanUntil(cur, end, ByteSet('\n'))) < end; cur++) {
+        _lineStarts.push_back(offset + static_cast<uint32_t>(cur + 1 - begin));
+    }
+}
+
+LineColumn LineIndex::locate(uint32_t offset) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_begin) {
+        addLineStarts(_begin, _end, 0);
+        _begin = _end = nullptr;
+    }
+    size_t line = std::upper_bound(_lineStarts.begin(), _lineStarts.end(), offset) - _lineStarts.begin();
+    return { static_cast<int>(line), static_cast<int>(offset - _lineStarts[line - 1]) + 1 };
+}
+
+FileId SourceMap::addFile(const std::string &name) {
+    _files.push_back(std::unique_ptr<File>(new File{ name, LineIndex() }));
+    return static_cast<FileId>(_files.size() - 1);
+}
+
+SourceMap &sourceMap() {
+    static SourceMap map;
+    return map;
+}
@@ -0,0 +1,81 @@
+/** ***************************************************************************
+ * @remark Source positions. Tokens and tree nodes keep byte spans; line    *
+ *          and column are looked up in a per-file index of line starts    *
+ *          that is built the first time a diagnostic or printer asks.     *
+ *                                                                            *
+ * @file  SourceMap.h                                                         *
+ *****************************************************************************/
+
+#ifndef SOURCEMAP_H
+#define SOURCEMAP_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using FileId = uint32_t;
+// File of positions that are not in any source, such as sentinel tokens
+constexpr FileId NO_FILE = UINT32_MAX;
+
+struct LineColumn {
+    int line;     // 1-based
+    int column;   // 1-based, in bytes
+};
+
+// Bytes [offset, offset + length) of a source file. Spans outside any file
+// (NO_FILE) hold a fixed line number in offset instead.
+struct SourceSpan {
+    FileId file = NO_FILE;
+    uint32_t offset = 0;
+    uint32_t length = 0;
+
+    int line() const;
+    LineColumn location() const;
+    // From the start of this span to the end of last
+    SourceSpan through(const SourceSpan &last) const;
+};
+
+// Offsets of the line starts of one source text
+class LineIndex {
+public:
+    // The whole text, indexed on the first lookup. The text has to stay
+    // alive until then; setting it again drops the old index.
+    void setText(const char* begin, const char* end);
+    // Text read from a stream, indexed as it arrives. offset is where begin
+    // lies in the stream.
+    void appendText(const char* begin, const char* end, uint32_t offset);
+    LineColumn locate(uint32_t offset);
+
+private:
+    std::mutex _mutex;
+    const char* _begin = nullptr;
+    const char* _end = nullptr;
+    std::vector<uint32_t> _lineStarts = { 0 };
+
+    void addLineStarts(const char* begin, const char* end, uint32_t offset);
+};
+
+class SourceMap {
+public:
+    SourceMap() = default;
+    SourceMap(const SourceMap &) = delete;
+    SourceMap &operator=(const SourceMap &) = delete;
+
+    FileId addFile(const std::string &name);
+    const std::string &name(FileId file) const { return _files[file]->name; }
+    LineIndex &lines(FileId file) { return _files[file]->lines; }
+
+private:
+    struct File {
+        std::string name;
+        LineIndex lines;
+    };
+    std::vector<std::unique_ptr<File>> _files;
+};
+
+// Files of this run
+SourceMap &sourceMap();
+
+#endif // SOURCEMAP_H
@@ -0,0 +1,109 @@
+/** ***************************************************************************
+ * @remark Bounded lock-free ring buffer between exactly one producer thread *
+ *          and one consumer thread. Each side owns one index and only     *
+ *          reads the other's, so no locks or read-modify-writes are needed.*
+ *                                                                            *
+ * @file  SpscQueue.h                                                         *
+ *****************************************************************************/
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+// How often each side found the queue in its way, for telling which end of
+// a pipeline is the bottleneck. Producer fields are only written by the
+// producer and consumer fields by the consumer; read them once both are done.
+struct QueueStats {
+    uint64_t pushes = 0;
+    uint64_t fullWaits = 0;       // pushes that found the queue full
+    uint64_t pops = 0;
+    uint64_t emptyWaits = 0;      // pops that found the queue empty
+    uint64_t occupancySum = 0;    // items queued as seen by each pop
+
+    double meanOccupancy() const { return pops ? double(occupancySum) / pops : 0.0; }
+};
+
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() = default;
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Producer side, false if the queue is full
+    bool tryPush(T &value) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        _slots[tail & (Capacity - 1)] = std::move(value);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    // Producer side, waits for room unless stop is raised first
+    bool push(T &value, const std::atomic<bool> &stop) {
+        _pushes++;
+        if (tryPush(value)) {
+            return true;
+        }
+        _fullWaits++;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (tryPush(value)) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    // Consumer side, false if the queue is empty
+    bool tryPop(T &value) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t tail = _tail.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        _occupancySum += tail - head;
+        value = std::move(_slots[head & (Capacity - 1)]);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    // Consumer side, waits for an item
+    void pop(T &value) {
+        _pops++;
+        if (tryPop(value)) {
+            return;
+        }
+        _emptyWaits++;
+        while (!tryPop(value)) {
+            std::this_thread::yield();
+        }
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+    QueueStats stats() const {
+        return QueueStats{ _pushes, _fullWaits, _pops, _emptyWaits, _occupancySum };
+    }
+
+private:
+    // Indices only grow, slot = index % Capacity. Each side's index and
+    // counters sit on their own cache line so the threads do not fight over one.
+    alignas(64) std::atomic<size_t> _head{ 0 };    // next slot to pop, owned by the consumer
+    uint64_t _pops = 0;
+    uint64_t _emptyWaits = 0;
+    uint64_t _occupancySum = 0;
+    alignas(64) std::atomic<size_t> _tail{ 0 };    // next slot to push, owned by the producer
+    uint64_t _pushes = 0;
+    uint64_t _fullWaits = 0;
+    alignas(64) std::array<T, Capacity> _slots;
+};
+
+#endif // SPSCQUEUE_H
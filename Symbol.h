@@ -10,17 +10,21 @@
 #define SYMBOL_H
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include "NamePool.h"
+#include "SourceMap.h"
 using namespace std;
 
 struct Symbol {
-    string name;
+    NameId nameId;       // lookups compare this
+    string_view name;    // spelling owned by namePool()
     string idType;       // datatype, function, or procedure
     string dataType;     // variables - datatype; functions - return type; procedures - NOT APPLICABLE
     int scope;
     bool isArray;
     int arraySize;
-    int line;
+    SourceSpan span;     // where it is declared
     vector<Symbol> parameters;
 };
 
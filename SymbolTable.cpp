@@ -11,8 +11,6 @@
 
 using namespace std;
 
-bool symbolError = false;
-static int nextScope = 1;
 
 SymbolTable::~SymbolTable() {
     while (head) {
@@ -22,14 +20,18 @@ SymbolTable::~SymbolTable() {
     }
 }
 
-bool SymbolTable::parameterExistsInScope(const string &name, int scope) {
+void SymbolTable::error(SourceSpan span, string message) {
+    diagnostics.report(DiagnosticKind::SEMANTIC, span, std::move(message));
+}
+
+bool SymbolTable::parameterExistsInScope(NameId nameId, int scope) {
     SymbolNode* cur = head;
     while (cur) {
         if ((cur->symbol.idType == "function" || cur->symbol.idType == "procedure") &&
             cur->symbol.scope == scope) {
             // Check if any parameter has the same name
             for (const auto &param : cur->symbol.parameters) {
-                    if (param.name == name)
+                    if (param.nameId == nameId)
                         return true;
                 }
             }
@@ -41,17 +43,17 @@ bool SymbolTable::parameterExistsInScope(const string &name, int scope) {
 bool SymbolTable::addSymbol(const Symbol& symbol) {
     // check for a global duplicate
     if (symbol.idType == "datatype" && symbol.scope != 0) {
-        if (lookup(symbol.name, 0) != nullptr) {
+        if (lookup(symbol.nameId, 0) != nullptr) {
             return false;
         }
     }
     // check for duplicate in current scope
-    if (lookup(symbol.name, symbol.scope) != nullptr) {
+    if (lookup(symbol.nameId, symbol.scope) != nullptr) {
         return false;
     }
     // check for duplicates in the function/procedure parameter list
     if (symbol.idType == "datatype" && symbol.scope != 0) {
-        if (parameterExistsInScope(symbol.name, symbol.scope)) {
+        if (parameterExistsInScope(symbol.nameId, symbol.scope)) {
             return false;
         }
     }
@@ -65,10 +67,10 @@ bool SymbolTable::addSymbol(const Symbol& symbol) {
     return true;
 }
 
-Symbol* SymbolTable::lookup(const string& name, int scope) {
+Symbol* SymbolTable::lookup(NameId nameId, int scope) {
     SymbolNode* cur = head;
     while (cur) {
-        if (cur->symbol.name == name && cur->symbol.scope == scope) {
+        if (cur->symbol.nameId == nameId && cur->symbol.scope == scope) {
             return &cur->symbol;
         }
         cur = cur->next;
@@ -105,7 +107,7 @@ void SymbolTable::print() {
     }
 }
 
-bool isValidIdentifier(const string &tokenText) {
+bool isValidIdentifier(string_view tokenText) {
     if (tokenText.empty()) {
         return false;
     }
@@ -113,6 +115,22 @@ bool isValidIdentifier(const string &tokenText) {
     return isalpha(c) || (c == '_');
 }
 
+// Give a symbol the interned name of the CST node that declares it
+static void nameSymbol(Symbol &symbol, const Node* node) {
+    // Terminals from the tokenizer are already interned
+    symbol.nameId = node->nameId != NO_NAME ? node->nameId : namePool().intern(node->name);
+    symbol.name = namePool().spelling(symbol.nameId);
+}
+
+// Value of an integer terminal (an array size), 0 if the node is not one
+static int integerValue(const Node* node) {
+    if (node->literal == NO_LITERAL) {
+        return 0;
+    }
+    const Literal &literal = literalPool().get(node->literal);
+    return literal.kind == LiteralKind::INTEGER ? literal.value : 0;
+}
+
 vector<Node*> flattenParameterNodes(Node* node) {
     vector<Node*> params;
     if (!node) {
@@ -138,7 +156,7 @@ vector<Node*> flattenParameterNodes(Node* node) {
     return params;
 }
 
-void processIdentifierList(Node* node, int curScope, const string &datatype, SymbolTable &st) {
+void processIdentifierList(Node* node, int curScope, string_view datatype, SymbolTable &st) {
     if (!node) {
         return;
     }
@@ -152,20 +170,17 @@ void processIdentifierList(Node* node, int curScope, const string &datatype, Sym
         int arraySize = 0;
         if (node->rightSibling && node->rightSibling->name == "[") {
             Node* sizeNode = node->rightSibling->rightSibling;
-            if (sizeNode && isdigit(sizeNode->name[0])) {
-                arraySize = stoi(sizeNode->name);
+            if (sizeNode && integerValue(sizeNode) > 0) {
+                arraySize = integerValue(sizeNode);
                 isArray = true;
             }
         }
-        Symbol s { node->name, "datatype", datatype, curScope, isArray, arraySize, node->lineNumber };
+        Symbol s { NO_NAME, "", "datatype", string(datatype), curScope, isArray, arraySize, node->span, {} };
+        nameSymbol(s, node);
         if (!st.addSymbol(s)) {
-            symbolError = true;
-            if (s.scope != 0 && st.lookup(s.name, 0) != nullptr) {
-                cerr << "Error on line " << s.line << ": variable '" << s.name << "' is already defined globally\n";
-            }
-            else {
-                cerr << "Error on line " << s.line << ": variable '" << s.name << "' is already defined locally\n";
-            }
+            string where = (s.scope != 0 && st.lookup(s.nameId, 0) != nullptr) ? "globally" : "locally";
+            st.error(s.span, "Error on line " + to_string(s.span.line()) + ": variable '" +
+                             string(s.name) + "' is already defined " + where);
         }
     }
     processIdentifierList(node->rightSibling, curScope, datatype, st);
@@ -177,7 +192,7 @@ void traverseCST(Node* node, int curScope, SymbolTable& symbolTable) {
     }
     // begin DeclarationStatement
     if (node->name == "DeclarationStatement") {
-        string datatype = (node->leftChild ? node->leftChild->name : "");
+        string_view datatype = (node->leftChild ? node->leftChild->name : "");
         processIdentifierList(node->leftChild ? node->leftChild->rightSibling : nullptr, curScope, datatype, symbolTable);
         traverseCST(node->rightSibling, curScope, symbolTable);
         return;
@@ -187,19 +202,19 @@ void traverseCST(Node* node, int curScope, SymbolTable& symbolTable) {
         Node* retTypeNode = (node->leftChild ? node->leftChild->rightSibling : nullptr);
         Node* funcNameNode = (retTypeNode ? retTypeNode->rightSibling : nullptr);
         if (funcNameNode && isValidIdentifier(funcNameNode->name)) {
-            string funcName = funcNameNode->name;
-            int funcScope = nextScope++;
+            int funcScope = symbolTable.newScope();
             Symbol funcSym;
-            funcSym.name = funcName;
+            nameSymbol(funcSym, funcNameNode);
             funcSym.idType = "function";
             funcSym.dataType = (retTypeNode ? retTypeNode->name : "unknown");
             funcSym.scope = funcScope;
             funcSym.isArray = false;
             funcSym.arraySize = 0;
-            funcSym.line = funcNameNode->lineNumber;
+            funcSym.span = funcNameNode->span;
             if (!symbolTable.addSymbol(funcSym)) {
-                cerr << "Error on line " << funcNameNode->lineNumber
-                     << ": function '" << funcName << "' is already defined in scope " << funcScope << ".\n";
+                symbolTable.error(funcNameNode->span, "Error on line " + to_string(funcNameNode->span.line()) +
+                                  ": function '" + string(funcSym.name) + "' is already defined in scope " +
+                                  to_string(funcScope) + ".");
             }
             //Begin parameterList
             Node* paramList = nullptr;
@@ -215,7 +230,7 @@ void traverseCST(Node* node, int curScope, SymbolTable& symbolTable) {
                 // Flatten the parameter list into a vector
                 vector<Node*> realParams = flattenParameterNodes(paramList->leftChild);
                 // pair datatypes with identifier
-                for (int i = 0; i + 1 < realParams.size(); i += 2) {
+                for (size_t i = 0; i + 1 < realParams.size(); i += 2) {
                     Node* typeNode = realParams[i];
                     Node* nameNode = realParams[i+1];
                     // If the parameter node is non-terminal derivation, use leftChild
@@ -228,20 +243,20 @@ void traverseCST(Node* node, int curScope, SymbolTable& symbolTable) {
                     if (nameNode && nameNode->rightSibling && nameNode->rightSibling->name == "[") {
                         Node* sizeNode = nameNode->rightSibling->rightSibling;
                         if (sizeNode) {
-                            arraySize = stoi(sizeNode->name);
+                            arraySize = integerValue(sizeNode);
                             isArray = true;
                         }
                     }
                     if (nameNode && isValidIdentifier(nameNode->name)) {
                         Symbol p;
-                        p.name = nameNode->name;
+                        nameSymbol(p, nameNode);
                         p.idType = "datatype";
                         p.dataType = typeNode->name;
                         p.scope = funcScope;
                         p.isArray = isArray;
                         p.arraySize = arraySize;
-                        p.line = nameNode->lineNumber;
-                        Symbol* funcEntry = symbolTable.lookup(funcName, funcScope);
+                        p.span = nameNode->span;
+                        Symbol* funcEntry = symbolTable.lookup(funcSym.nameId, funcScope);
                         if (funcEntry) {
                             funcEntry->parameters.push_back(p);
                         }
@@ -268,20 +283,20 @@ void traverseCST(Node* node, int curScope, SymbolTable& symbolTable) {
         if (node->leftChild) {
             Node* procNameNode = node->leftChild->rightSibling;
             if (procNameNode && isValidIdentifier(procNameNode->name)) {
-                int procScope = nextScope++;
+                int procScope = symbolTable.newScope();
                 string dtype = "NOT APPLICABLE";
                 Symbol procSym;
-                procSym.name = procNameNode->name;
+                nameSymbol(procSym, procNameNode);
                 procSym.idType = "procedure";
                 procSym.dataType = dtype;
                 procSym.scope = procScope;
                 procSym.isArray = false;
                 procSym.arraySize = 0;
-                procSym.line = procNameNode->lineNumber;
+                procSym.span = procNameNode->span;
                 if (!symbolTable.addSymbol(procSym)) {
-                    cerr << "Error on line " << procNameNode->lineNumber
-                         << ": procedure '" << procNameNode->name
-                         << "' is already defined in scope " << procScope << ".\n";
+                    symbolTable.error(procNameNode->span, "Error on line " + to_string(procNameNode->span.line()) +
+                                      ": procedure '" + string(procNameNode->name) +
+                                      "' is already defined in scope " + to_string(procScope) + ".");
                 }
                 // check ParameterList for procedure if it exists
                 Node* paramList = nullptr;
@@ -295,7 +310,7 @@ void traverseCST(Node* node, int curScope, SymbolTable& symbolTable) {
                 }
                 if (paramList) {
                     vector<Node*> realParams = flattenParameterNodes(paramList->leftChild);
-                    for (int i = 0; i + 1 < realParams.size(); i += 2) {
+                    for (size_t i = 0; i + 1 < realParams.size(); i += 2) {
                         Node* typeNode = realParams[i];
                         Node* nameNode = realParams[i+1];
                         if (nameNode && (nameNode->name == "IdentifierAndIdentifierArrayParameterListDeclaration" ||
@@ -307,20 +322,20 @@ void traverseCST(Node* node, int curScope, SymbolTable& symbolTable) {
                         if (nameNode && nameNode->rightSibling && nameNode->rightSibling->name == "[") {
                             Node* sizeNode = nameNode->rightSibling->rightSibling;
                             if (sizeNode) {
-                                arraySize = stoi(sizeNode->name);
+                                arraySize = integerValue(sizeNode);
                                 isArray = true;
                             }
                         }
                         if (nameNode && isValidIdentifier(nameNode->name)) {
                             Symbol p;
-                            p.name = nameNode->name;
+                            nameSymbol(p, nameNode);
                             p.idType = "datatype";
                             p.dataType = typeNode->name;
                             p.scope = procScope;
                             p.isArray = isArray;
                             p.arraySize = arraySize;
-                            p.line = nameNode->lineNumber;
-                            Symbol* procEntry = symbolTable.lookup(procNameNode->name, procScope);
+                            p.span = nameNode->span;
+                            Symbol* procEntry = symbolTable.lookup(procSym.nameId, procScope);
                             if (procEntry) {
                                 procEntry->parameters.push_back(p);
                             }
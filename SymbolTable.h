@@ -11,29 +11,37 @@
 
 #include "Symbol.h"
 #include "Node.h"
+#include "Diagnostics.h"
 
 class SymbolTable {
     struct SymbolNode {
         Symbol symbol;
         SymbolNode* next;
-        SymbolNode(const Symbol& symbol) : symbol(symbol), next(nullptr) {}
+        SymbolNode(const Symbol& s) : symbol(s), next(nullptr) {}
     };
     SymbolNode* head;
     SymbolNode* tail;
+    // Redefinitions are reported here, the table is still built
+    Diagnostics &diagnostics;
+    int nextScope = 1;
 
     public:
-    SymbolTable() : head(nullptr), tail(nullptr) {}
+    explicit SymbolTable(Diagnostics &reports) : head(nullptr), tail(nullptr), diagnostics(reports) {}
     ~SymbolTable();
 
-    bool parameterExistsInScope(const string &name, int scope);
+    // Scope number for the next function or procedure, in source order
+    int newScope() { return nextScope++; }
+    void error(SourceSpan span, string message);
+    bool hasErrors() const { return diagnostics.has(DiagnosticKind::SEMANTIC); }
+
+    bool parameterExistsInScope(NameId nameId, int scope);
 
     bool addSymbol(const Symbol& symbol);
-    Symbol* lookup(const string& name, int scope);
+    Symbol* lookup(NameId nameId, int scope);
     void print();
 };
 
 void traverseCST(Node* node, int curScope, SymbolTable& symbolTable);
-bool isValidIdentifier(const string& identifier);
-extern bool symbolError;
+bool isValidIdentifier(string_view identifier);
 
 #endif //SYMBOLTABLE_H
@@ -12,61 +12,58 @@
 #define TOKEN_H
 
 #include <string>
+#include <string_view>
+#include <cstdint>
+#include "NamePool.h"
+#include "LiteralPool.h"
+#include "SourceMap.h"
+#include "TokenSpec.h"
 using namespace std;
 
-//DFA States
-enum class Type {
-    IDENTIFIER,
-    L_PAREN, R_PAREN,
-    L_BRACE, R_BRACE,
-    L_BRACKET, R_BRACKET,
-    SEMICOLON,
-    ASSIGNMENT_OPERATOR,
-    DOUBLE_QUOTE, SINGLE_QUOTE,
-    STRING,
-    INTEGER,
-    COMMA,
-    MODULO,
-    BOOLEAN_EQUAL, BOOLEAN_AND, BOOLEAN_NOT_EQUAL, BOOLEAN_OR, BOOLEAN_NOT,
-    BOOLEAN_TRUE, BOOLEAN_FALSE,
-    ASTERISK, PLUS, MINUS, DIVIDE,
-    LT_EQUAL, GT_EQUAL, LT, GT,
-    CARET,
-    RETURN_KEYWORD,
-    CHAR, BOOL, INT,
-    IF, ELSE, WHILE, FOR,
-    PRINTF, FUNCTION, PROCEDURE,
-    GETCHAR, VOID, SIZEOF,
-    DOUBLE_QUOTED_STRING, SINGLE_QUOTED_STRING,
-    //Error States
-    ERROR_INVALID_INT, ERROR_INVALID_IDENTIFIER, ERROR_UNCLOSED_STRING,
-    ERROR_UNCLOSED_CHAR, ERROR_INVALID_CHAR, ERROR_INVALID_OPERATOR,
-    END_OF_FILE
-};
-
+// Tokens do not own their text, it is a view into the source buffer the
+// tokenizer read, which has to stay alive as long as the tokens do. Their
+// position is a span, the line is only looked up when asked for.
 class Token {
 public:
-    Token(Type type, const string &text, int line);
+    // text points at the first of span.length bytes
+    Token(Type type, const char* text, SourceSpan span,
+          NameId nameId = NO_NAME, LiteralId literal = NO_LITERAL);
+    // Token outside any source over text that outlives it (string literals
+    // for sentinel tokens)
+    Token(Type type, string_view text, int line);
 
     Type getType() const { return _type; }
-    string getText() const { return _text; }
-    int getLine() const { return _line; }
-    string getTypeName() const;
-    bool isEndOfFile() const;
+    string_view getText() const { return string_view(_text, _span.length); }
+    const SourceSpan &getSpan() const { return _span; }
+    int getLine() const { return _span.line(); }
+    uint32_t getOffset() const { return _span.offset; }
+    uint32_t getLength() const { return _span.length; }
+    // Interned id of identifiers, keywords and string contents, NO_NAME otherwise
+    NameId getNameId() const { return _nameId; }
+    // Decoded value in literalPool() of integers and char/string contents
+    LiteralId getLiteral() const { return _literal; }
+    // Move the token onto an edited copy of its source starting at base
+    void rebase(const char* base, int32_t offsetDelta);
+    string_view getTypeName() const { return typeNameOf(_type); }
+    static string_view typeName(Type type) { return typeNameOf(type); }
+    bool isEndOfFile() const { return _type == Type::END_OF_FILE; }
+    bool isOneOf(TypeSet types) const { return inSet(types, _type); }
 
-    bool isIdentifier() const;
-    bool isInteger() const;
-    bool isString() const;
-    bool isOperator() const;
-    bool isBoolean() const;
-    bool isChar() const;
-    bool isDelimiter() const;
-    bool isError() const;
+    bool isIdentifier() const { return _type == Type::IDENTIFIER; }
+    bool isInteger() const { return _type == Type::INTEGER; }
+    bool isString() const { return inSet(STRING_TYPES, _type); }
+    bool isOperator() const { return inSet(OPERATOR_TYPES, _type); }
+    bool isBoolean() const { return inSet(BOOLEAN_TYPES, _type); }
+    bool isChar() const { return _type == Type::SINGLE_QUOTE; }
+    bool isDelimiter() const { return inSet(DELIMITER_TYPES, _type); }
+    bool isError() const { return inSet(ERROR_TYPES, _type); }
 
 private:
     Type _type;
-    string _text;
-    int _line;
+    SourceSpan _span;
+    NameId _nameId;
+    LiteralId _literal;
+    const char* _text;
 };
 
 
@@ -3,80 +3,94 @@
 #include "Token.h"
 #include <iostream>
 
-TokenList::TokenList() : head(nullptr), tail(nullptr), _size(0) {}
+// Sentinels handed out past the end of the list, so callers can take a reference
+static const Token endOfList(Type::END_OF_FILE, "", 0);
+static const Token endOfLookahead(Type::END_OF_FILE, "", -1);
 
-TokenList::~TokenList() {
-    while (head != nullptr) {
-        TokenNode* temp = head;
-        head = head->next;
-        delete temp;
+TokenList::TokenList() : _cursor(0) {}
+
+TokenList::TokenList(Generator<Token> &&source) : _cursor(0), _source(std::move(source)) {
+    _tokens.reserve(2 * WINDOW_SLACK);
+}
+
+void TokenList::fill(size_t n) {
+    while (_source && _tokens.size() - _cursor <= n) {
+        // Drop consumed tokens, keeping the last one for push_front. Only the
+        // lookahead is moved, so this stays cheap.
+        if (_cursor > WINDOW_SLACK) {
+            _tokens.erase(_tokens.begin(), _tokens.begin() + (_cursor - 1));
+            _cursor = 1;
+        }
+        if (!_source->next()) {
+            _source.reset();
+            break;
+        }
+        _tokens.push_back(_source->value());
+        if (_tokens.back().isEndOfFile()) {
+            _source.reset();
+        }
     }
-    tail = nullptr;
-    _size = 0;
+}
+
+void TokenList::drain() {
+    fill(SIZE_MAX - 1);
 }
 
 void TokenList::push_back(const Token &t) {
-    TokenNode* newNode = new TokenNode(t);
-    if (!head) {
-        head = newNode;
-        tail = newNode;
-    } else {
-        tail->next = newNode;
-        tail = newNode;
-    }
-    _size++;
+    _tokens.push_back(t);
 }
 
-Token TokenList::front() const {
-    if (!head) {
-        return Token(Type::END_OF_FILE, "", 0);
+const Token& TokenList::front() {
+    fill(0);
+    if (_cursor == _tokens.size()) {
+        return endOfList;
     }
-    return head->token;
+    return _tokens[_cursor];
 }
 
 void TokenList::pop_front() {
-    if (!head) return;
-    TokenNode* temp = head;
-    head = head->next;
-    if (!head) {
-        tail = nullptr;
-    }
-    delete temp;
-    _size--;
+    fill(0);
+    if (_cursor == _tokens.size()) return;
+    _cursor++;
 }
 
-bool TokenList::empty() const {
-    return (head == nullptr);
+bool TokenList::empty() {
+    fill(0);
+    return _cursor == _tokens.size();
 }
 
-size_t TokenList::size() const {
-    return _size;
+size_t TokenList::size() {
+    drain();
+    return _tokens.size() - _cursor;
 }
 
-void TokenList::printAllTokens() const {
-    TokenNode* cur = head;
-    while (cur) {
+void TokenList::printAllTokens() {
+    drain();
+    for (size_t i = _cursor; i < _tokens.size(); i++) {
         std::cout
-          << "Token type: " << cur->token.getTypeName() << "\n"
-          << "Token text: " << cur->token.getText() << "\n"
-          << "Line:       " << cur->token.getLine() << "\n\n";
-        cur = cur->next;
+          << "Token type: " << _tokens[i].getTypeName() << "\n"
+          << "Token text: " << _tokens[i].getText() << "\n"
+          << "Line:       " << _tokens[i].getLine() << "\n\n";
     }
 }
 
-Token TokenList::peekNext() const {
-    if (!head || !head->next) {
-        return Token(Type::END_OF_FILE, "", -1);
+const Token& TokenList::peekNext() {
+    return peek(1);
+}
+
+const Token& TokenList::peek(size_t n) {
+    fill(n);
+    if (n >= _tokens.size() - _cursor) {
+        return endOfLookahead;
     }
-    return head->next->token;
+    return _tokens[_cursor + n];
 }
 
 void TokenList::push_front(const Token& t) {
-    TokenNode* node = new TokenNode(t);
-    node->next = head;
-    head = node;
-    if (tail == nullptr) {
-        tail = node;
+    // Reuse the slot of the last consumed token when there is one
+    if (_cursor > 0) {
+        _tokens[--_cursor] = t;
+    } else {
+        _tokens.insert(_tokens.begin(), t);
     }
-    ++_size;
 }
@@ -1,40 +1,52 @@
-
 #ifndef TOKENLIST_H
 #define TOKENLIST_H
 
+#include <optional>
+#include <vector>
+#include "Generator.h"
 #include "Token.h"
 
 using namespace std;
 
-struct TokenNode {
-    Token token;
-    TokenNode* next;
-
-    TokenNode(const Token& t) : token(t), next(nullptr) {}
-};
-
+// Tokens are stored contiguously, consumed tokens are skipped by a cursor
+// so front/pop_front/peek are all O(1). A list built on a token stream pulls
+// tokens only as they are looked at and drops consumed ones, so it holds a
+// small window instead of the whole file. References returned by front()
+// and peek() are valid until the list is next read or changed.
 class TokenList {
 public:
     TokenList();
-    ~TokenList();
-    TokenNode* getHead() const {return head;}
+    // Pull tokens from source up to its first END_OF_FILE
+    explicit TokenList(Generator<Token> &&source);
     // Add a token to the end of the list
     void push_back(const Token &t);
     void push_front(const Token& t);
     // get front token without removing it
-    Token front() const;
+    const Token& front();
     // remove front token
     void pop_front();
-    bool empty() const;
-    size_t size() const;
+    bool empty();
+    // Number of tokens not yet consumed, pulls the rest of a stream
+    size_t size();
+    // Pull the rest of a stream, e.g. so the source reports its errors
+    void drain();
     // Debug print
-    void printAllTokens() const;
-    Token peekNext() const;
+    void printAllTokens();
+    const Token& peekNext();
+    // n-th token after the front (0 is the front), END_OF_FILE past the end
+    const Token& peek(size_t n);
 
 private:
-    TokenNode* head;
-    TokenNode* tail;
-    size_t     _size;
+    // Consumed tokens kept before the window is compacted
+    static constexpr size_t WINDOW_SLACK = 64;
+
+    vector<Token> _tokens;
+    size_t _cursor;
+    // Unset once the stream has handed out its END_OF_FILE
+    optional<Generator<Token>> _source;
+
+    // Make sure the n-th token after the front is in the window, if any
+    void fill(size_t n);
 };
 
 #endif // TOKENLIST_H
@@ -0,0 +1,118 @@
+/** ***************************************************************************
+ * @remark Pipelined front-end. The tokenizer runs on its own thread and     *
+ *          hands tokens to the parser in batches through a lock-free ring  *
+ *          buffer, so lexing and parsing overlap instead of adding up.     *
+ *                                                                            *
+ * @file  TokenPipeline.cpp                                                   *
+ *****************************************************************************/
+
+#include "TokenPipeline.h"
+#include <iomanip>
+
+using namespace std;
+
+TokenPipeline::TokenPipeline(const string &inputFile)
+    : _tokenizer(inputFile, _names, _literals) {
+    _lexer = thread(&TokenPipeline::lex, this);
+}
+
+TokenPipeline::~TokenPipeline() {
+    // Lets a lexer blocked on a full queue give up if tokens() stopped early
+    _stop = true;
+    if (_lexer.joinable()) {
+        _lexer.join();
+    }
+}
+
+void TokenPipeline::lex() {
+    Clock::time_point start = Clock::now();
+    size_t namesSent = 0;
+    size_t literalsSent = 0;
+    bool last = false;
+    while (!last) {
+        Batch batch;
+        if (!_spare.tryPop(batch)) {
+            batch.tokens.reserve(BATCH_TOKENS);
+        }
+        batch.tokens.clear();
+        batch.names.clear();
+        batch.literals.clear();
+        while (batch.tokens.size() < BATCH_TOKENS) {
+            batch.tokens.push_back(_tokenizer.getToken());
+            const Token &token = batch.tokens.back();
+            if (token.isEndOfFile() || token.isError()) {
+                last = true;
+                break;
+            }
+        }
+        // Pool blocks never move, the views stay valid on the other thread
+        for (; namesSent < _names.size(); namesSent++) {
+            batch.names.push_back(_names.spelling(static_cast<NameId>(namesSent)));
+        }
+        for (; literalsSent < _literals.size(); literalsSent++) {
+            batch.literals.push_back(_literals.get(static_cast<LiteralId>(literalsSent)));
+        }
+        batch.last = last;
+
+        Clock::time_point waitStart = Clock::now();
+        bool pushed = _full.push(batch, _stop);
+        _lexWait += Clock::now() - waitStart;
+        if (!pushed) {
+            break;
+        }
+    }
+    _lexTime = Clock::now() - start;
+}
+
+Generator<Token> TokenPipeline::tokens() {
+    _parseStart = Clock::now();
+    // Lexer pool id -> global pool id, the lexer's ids are dense and arrive in order
+    vector<NameId> globalIds;
+    vector<LiteralId> globalLiterals;
+    Batch batch;
+    bool last = false;
+    while (!last) {
+        Clock::time_point waitStart = Clock::now();
+        _full.pop(batch);
+        _parseWait += Clock::now() - waitStart;
+
+        for (string_view name : batch.names) {
+            globalIds.push_back(namePool().intern(name));
+        }
+        for (const Literal &literal : batch.literals) {
+            globalLiterals.push_back(literalPool().add(literal));
+        }
+        for (const Token &t : batch.tokens) {
+            NameId id = t.getNameId() != NO_NAME ? globalIds[t.getNameId()] : NO_NAME;
+            LiteralId literal = t.getLiteral() != NO_LITERAL ? globalLiterals[t.getLiteral()] : NO_LITERAL;
+            Token token(t.getType(), t.getText().data(), t.getSpan(), id, literal);
+            co_yield token;
+        }
+        last = batch.last;
+        // Dropped if the lexer already has enough spares
+        _spare.tryPush(batch);
+    }
+}
+
+void TokenPipeline::printStats(ostream &out) {
+    // The consumer usually stops at END_OF_FILE without resuming tokens()
+    // again, so its stage runs until now
+    Clock::duration parseTime = Clock::now() - _parseStart;
+    if (_lexer.joinable()) {
+        _lexer.join();
+    }
+    auto ms = [](Clock::duration d) {
+        return chrono::duration<double, milli>(d).count();
+    };
+    QueueStats queue = _full.stats();
+    out << fixed << setprecision(1)
+        << "pipeline: lexer  " << ms(_lexTime - _lexWait) << " ms working, "
+        << ms(_lexWait) << " ms waiting for room (" << queue.fullWaits
+        << " of " << queue.pushes << " batches)\n"
+        << "pipeline: parser " << ms(parseTime - _parseWait) << " ms working, "
+        << ms(_parseWait) << " ms waiting for tokens (" << queue.emptyWaits
+        << " of " << queue.pops << " batches)\n"
+        << "pipeline: queue  " << queue.meanOccupancy() << " of "
+        << _full.capacity() << " batches full on average\n";
+    out.unsetf(ios::floatfield);
+}
@@ -0,0 +1,78 @@
+/** ***************************************************************************
+ * @remark Pipelined front-end. The tokenizer runs on its own thread and     *
+ *          hands tokens to the parser in batches through a lock-free ring  *
+ *          buffer, so lexing and parsing overlap instead of adding up.     *
+ *                                                                            *
+ * @file  TokenPipeline.h                                                     *
+ *****************************************************************************/
+
+#ifndef TOKENPIPELINE_H
+#define TOKENPIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Generator.h"
+#include "SpscQueue.h"
+#include "Tokenizer.h"
+
+// Tokens view the pipeline's source, so it has to outlive them. Neither side
+// takes a lock: the lexer thread interns into pools of its own and every
+// batch carries the entries it added, which the consuming thread moves into
+// namePool() and literalPool() in order, so ids come out the same as a
+// serial run.
+class TokenPipeline {
+public:
+    // "-" streams standard input, as for Tokenizer
+    explicit TokenPipeline(const std::string &inputFile);
+    TokenPipeline(const TokenPipeline &) = delete;
+    TokenPipeline &operator=(const TokenPipeline &) = delete;
+    ~TokenPipeline();
+
+    // Tokens up to and including END_OF_FILE or the first error token, to be
+    // pulled on one thread only
+    Generator<Token> tokens();
+    bool isOpen() const { return _tokenizer.isOpen(); }
+    // Time each stage spent working and waiting on the other, and how full
+    // the queue ran. Call once tokens() is done.
+    void printStats(std::ostream &out);
+
+private:
+    static constexpr size_t BATCH_TOKENS = 512;
+    static constexpr size_t QUEUE_BATCHES = 16;
+    using Clock = std::chrono::steady_clock;
+
+    struct Batch {
+        std::vector<Token> tokens;
+        // Pool entries added while lexing these tokens, in id order
+        std::vector<std::string_view> names;
+        std::vector<Literal> literals;
+        bool last = false;
+    };
+
+    // Written by the lexer thread only
+    NamePool _names;
+    LiteralPool _literals;
+    Tokenizer _tokenizer;
+    Clock::duration _lexTime{};
+    Clock::duration _lexWait{};
+
+    // Lexed batches to the consumer, and emptied ones back for reuse
+    SpscQueue<Batch, QUEUE_BATCHES> _full;
+    SpscQueue<Batch, QUEUE_BATCHES> _spare;
+    std::atomic<bool> _stop{ false };
+    std::thread _lexer;
+
+    // Written by the consuming thread only
+    Clock::time_point _parseStart;
+    Clock::duration _parseWait{};
+
+    // Lexer thread body
+    void lex();
+};
+
+#endif // TOKENPIPELINE_H
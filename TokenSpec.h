@@ -0,0 +1,184 @@
+/** ***************************************************************************
+ * @remark Single specification of the token types. The printed names, the   *
+ *          category sets and the parser's FIRST sets are all generated from *
+ *          the one table below at compile time, so classifying a token is  *
+ *          a single bit test.                                                *
+ *                                                                            *
+ * @file  TokenSpec.h                                                         *
+ *****************************************************************************/
+
+#ifndef TOKENSPEC_H
+#define TOKENSPEC_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+//DFA States
+enum class Type {
+    IDENTIFIER,
+    L_PAREN, R_PAREN,
+    L_BRACE, R_BRACE,
+    L_BRACKET, R_BRACKET,
+    SEMICOLON,
+    ASSIGNMENT_OPERATOR,
+    DOUBLE_QUOTE, SINGLE_QUOTE,
+    STRING,
+    INTEGER,
+    COMMA,
+    MODULO,
+    BOOLEAN_EQUAL, BOOLEAN_AND, BOOLEAN_NOT_EQUAL, BOOLEAN_OR, BOOLEAN_NOT,
+    BOOLEAN_TRUE, BOOLEAN_FALSE,
+    ASTERISK, PLUS, MINUS, DIVIDE,
+    LT_EQUAL, GT_EQUAL, LT, GT,
+    CARET,
+    RETURN_KEYWORD,
+    CHAR, BOOL, INT,
+    IF, ELSE, WHILE, FOR,
+    PRINTF, FUNCTION, PROCEDURE,
+    GETCHAR, VOID, SIZEOF,
+    DOUBLE_QUOTED_STRING, SINGLE_QUOTED_STRING,
+    //Error States
+    ERROR_INVALID_INT, ERROR_INVALID_IDENTIFIER, ERROR_UNCLOSED_STRING,
+    ERROR_UNCLOSED_CHAR, ERROR_INVALID_CHAR, ERROR_INVALID_OPERATOR,
+    ERROR_UNCLOSED_COMMENT, ERROR_INTEGER_OVERFLOW,
+    END_OF_FILE
+};
+
+constexpr std::size_t TYPE_COUNT = static_cast<std::size_t>(Type::END_OF_FILE) + 1;
+
+// A set of token types, one bit per type
+using TypeSet = uint64_t;
+static_assert(TYPE_COUNT <= 64, "TypeSet needs one bit per token type");
+
+constexpr TypeSet typeBit(Type type) {
+    return TypeSet(1) << static_cast<unsigned>(type);
+}
+
+template <typename... Types>
+constexpr TypeSet typeSet(Types... types) {
+    return (TypeSet(0) | ... | typeBit(types));
+}
+
+constexpr bool inSet(TypeSet set, Type type) {
+    return (set & typeBit(type)) != 0;
+}
+
+// Categories a token type belongs to, a type can be in several
+enum TokenCategory : unsigned {
+    TC_NONE                = 0,
+    TC_STRING              = 1 << 0,   // string contents, with or without quotes
+    TC_OPERATOR            = 1 << 1,   // binary operators and assignment
+    TC_BOOLEAN             = 1 << 2,   // true and false
+    TC_DELIMITER           = 1 << 3,   // ; and ,
+    TC_ERROR               = 1 << 4,
+    TC_DATATYPE            = 1 << 5,   // char, bool, int
+    TC_NUMERICAL_OPERATOR  = 1 << 6,   // + - * / % ^
+    TC_RELATIONAL_OPERATOR = 1 << 7,   // == != < > <= >=
+    TC_BOOLEAN_OPERATOR    = 1 << 8,   // && ||
+};
+
+struct TokenSpec {
+    Type type;
+    std::string_view name;
+    unsigned categories;
+};
+
+// One row per Type, in enum order. Return, true and false print as
+// identifiers, the tokenizer output has always shown them that way.
+inline constexpr std::array<TokenSpec, TYPE_COUNT> tokenSpecs = {{
+    { Type::IDENTIFIER,               "IDENTIFIER",               TC_NONE },
+    { Type::L_PAREN,                  "L_PAREN",                  TC_NONE },
+    { Type::R_PAREN,                  "R_PAREN",                  TC_NONE },
+    { Type::L_BRACE,                  "L_BRACE",                  TC_NONE },
+    { Type::R_BRACE,                  "R_BRACE",                  TC_NONE },
+    { Type::L_BRACKET,                "L_BRACKET",                TC_NONE },
+    { Type::R_BRACKET,                "R_BRACKET",                TC_NONE },
+    { Type::SEMICOLON,                "SEMICOLON",                TC_DELIMITER },
+    { Type::ASSIGNMENT_OPERATOR,      "ASSIGNMENT_OPERATOR",      TC_OPERATOR },
+    { Type::DOUBLE_QUOTE,             "DOUBLE_QUOTE",             TC_NONE },
+    { Type::SINGLE_QUOTE,             "SINGLE_QUOTE",             TC_NONE },
+    { Type::STRING,                   "STRING",                   TC_STRING },
+    { Type::INTEGER,                  "INTEGER",                  TC_NONE },
+    { Type::COMMA,                    "COMMA",                    TC_DELIMITER },
+    { Type::MODULO,                   "MODULO",                   TC_OPERATOR | TC_NUMERICAL_OPERATOR },
+    { Type::BOOLEAN_EQUAL,            "BOOLEAN_EQUAL",            TC_OPERATOR | TC_RELATIONAL_OPERATOR },
+    { Type::BOOLEAN_AND,              "BOOLEAN_AND",              TC_OPERATOR | TC_BOOLEAN_OPERATOR },
+    { Type::BOOLEAN_NOT_EQUAL,        "BOOLEAN_NOT_EQUAL",        TC_OPERATOR | TC_RELATIONAL_OPERATOR },
+    { Type::BOOLEAN_OR,               "BOOLEAN_OR",               TC_OPERATOR | TC_BOOLEAN_OPERATOR },
+    { Type::BOOLEAN_NOT,              "BOOLEAN_NOT",              TC_NONE },
+    { Type::BOOLEAN_TRUE,             "IDENTIFIER",               TC_BOOLEAN },
+    { Type::BOOLEAN_FALSE,            "IDENTIFIER",               TC_BOOLEAN },
+    { Type::ASTERISK,                 "ASTERISK",                 TC_OPERATOR | TC_NUMERICAL_OPERATOR },
+    { Type::PLUS,                     "PLUS",                     TC_OPERATOR | TC_NUMERICAL_OPERATOR },
+    { Type::MINUS,                    "MINUS",                    TC_OPERATOR | TC_NUMERICAL_OPERATOR },
+    { Type::DIVIDE,                   "DIVIDE",                   TC_OPERATOR | TC_NUMERICAL_OPERATOR },
+    { Type::LT_EQUAL,                 "LT_EQUAL",                 TC_OPERATOR | TC_RELATIONAL_OPERATOR },
+    { Type::GT_EQUAL,                 "GT_EQUAL",                 TC_OPERATOR | TC_RELATIONAL_OPERATOR },
+    { Type::LT,                       "LT",                       TC_OPERATOR | TC_RELATIONAL_OPERATOR },
+    { Type::GT,                       "GT",                       TC_OPERATOR | TC_RELATIONAL_OPERATOR },
+    { Type::CARET,                    "CARET",                    TC_NUMERICAL_OPERATOR },
+    { Type::RETURN_KEYWORD,           "IDENTIFIER",               TC_NONE },
+    { Type::CHAR,                     "CHAR",                     TC_DATATYPE },
+    { Type::BOOL,                     "BOOL",                     TC_DATATYPE },
+    { Type::INT,                      "INT",                      TC_DATATYPE },
+    { Type::IF,                       "IF",                       TC_NONE },
+    { Type::ELSE,                     "ELSE",                     TC_NONE },
+    { Type::WHILE,                    "WHILE",                    TC_NONE },
+    { Type::FOR,                      "FOR",                      TC_NONE },
+    { Type::PRINTF,                   "PRINTF",                   TC_NONE },
+    { Type::FUNCTION,                 "FUNCTION",                 TC_NONE },
+    { Type::PROCEDURE,                "PROCEDURE",                TC_NONE },
+    { Type::GETCHAR,                  "GETCHAR",                  TC_NONE },
+    { Type::VOID,                     "VOID",                     TC_NONE },
+    { Type::SIZEOF,                   "SIZEOF",                   TC_NONE },
+    { Type::DOUBLE_QUOTED_STRING,     "DOUBLE_QUOTED_STRING",     TC_STRING },
+    { Type::SINGLE_QUOTED_STRING,     "SINGLE_QUOTED_STRING",     TC_STRING },
+    { Type::ERROR_INVALID_INT,        "ERROR_INVALID_INT",        TC_ERROR },
+    { Type::ERROR_INVALID_IDENTIFIER, "ERROR_INVALID_IDENTIFIER", TC_ERROR },
+    { Type::ERROR_UNCLOSED_STRING,    "ERROR_UNCLOSED_STRING",    TC_ERROR },
+    { Type::ERROR_UNCLOSED_CHAR,      "ERROR_UNCLOSED_CHAR",      TC_ERROR },
+    { Type::ERROR_INVALID_CHAR,       "ERROR_INVALID_CHAR",       TC_ERROR },
+    { Type::ERROR_INVALID_OPERATOR,   "ERROR_INVALID_OPERATOR",   TC_ERROR },
+    { Type::ERROR_UNCLOSED_COMMENT,   "ERROR_UNCLOSED_COMMENT",   TC_ERROR },
+    { Type::ERROR_INTEGER_OVERFLOW,   "ERROR_INTEGER_OVERFLOW",   TC_ERROR },
+    { Type::END_OF_FILE,              "END_OF_FILE",              TC_NONE },
+}};
+
+constexpr bool specsInEnumOrder() {
+    for (std::size_t i = 0; i < TYPE_COUNT; i++) {
+        if (static_cast<std::size_t>(tokenSpecs[i].type) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(specsInEnumOrder(), "tokenSpecs rows must follow the Type enum");
+
+// Every type whose row carries the category
+constexpr TypeSet typesIn(unsigned category) {
+    TypeSet set = 0;
+    for (const TokenSpec &spec : tokenSpecs) {
+        if (spec.categories & category) {
+            set |= typeBit(spec.type);
+        }
+    }
+    return set;
+}
+
+inline constexpr TypeSet STRING_TYPES              = typesIn(TC_STRING);
+inline constexpr TypeSet OPERATOR_TYPES            = typesIn(TC_OPERATOR);
+inline constexpr TypeSet BOOLEAN_TYPES             = typesIn(TC_BOOLEAN);
+inline constexpr TypeSet DELIMITER_TYPES           = typesIn(TC_DELIMITER);
+inline constexpr TypeSet ERROR_TYPES               = typesIn(TC_ERROR);
+inline constexpr TypeSet DATATYPE_TYPES            = typesIn(TC_DATATYPE);
+inline constexpr TypeSet NUMERICAL_OPERATOR_TYPES  = typesIn(TC_NUMERICAL_OPERATOR);
+inline constexpr TypeSet RELATIONAL_OPERATOR_TYPES = typesIn(TC_RELATIONAL_OPERATOR);
+inline constexpr TypeSet BOOLEAN_OPERATOR_TYPES    = typesIn(TC_BOOLEAN_OPERATOR);
+
+constexpr std::string_view typeNameOf(Type type) {
+    auto index = static_cast<std::size_t>(type);
+    return index < TYPE_COUNT ? tokenSpecs[index].name : "UNKNOWN_TOKEN_TYPE";
+}
+
+#endif // TOKENSPEC_H
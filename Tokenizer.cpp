@@ -9,310 +9,225 @@
  *****************************************************************************/
 
 #include "Tokenizer.h"
+#include "ByteScan.h"
+#include "CharClass.h"
+#include "Keywords.h"
+#include "LexTable.h"
+#include <cstring>
 #include <iostream>
-#include <cctype>
 
-Tokenizer::Tokenizer(const string &inputFile) {
-    inputStream.open(inputFile);
-    if (!inputStream.is_open()) {
-        cerr << "Error: Could not open file " << inputFile << std::endl;
-        exit(1);
-    }
+Tokenizer::Tokenizer(const string &inputFile, NamePool &names, LiteralPool &literals)
+    : _names(&names), _literals(&literals) {
+    if (inputFile == "-") {
+        // Empty window, the scan reads the first block when it gets there
+        _input.reset(new InputStream(inputFile));
+        _base = _cur = _end = _input->begin();
+        _file = sourceMap().addFile("<stdin>");
+    } else {
+        // A file that cannot be opened reads as empty, see isOpen()
+        _source.reset(new SourceBuffer(inputFile));
+        _base = _cur = _source->begin();
+        _end = _source->end();
+        _file = sourceMap().addFile(inputFile);
+        sourceMap().lines(_file).setText(_base, _end);
+    }
+    _stream = scan();
 }
 
-unsigned char Tokenizer::toUnsignedChar(char c) {
-    return static_cast<unsigned char>(c);
-}
+Tokenizer::Tokenizer(const char* base, const char* begin, const char* end, FileId file,
+                     NamePool &names, LiteralPool &literals)
+    : _base(base), _cur(begin), _end(end), _file(file), _names(&names), _literals(&literals),
+      _stream(scan()) {}
 
-void Tokenizer::skipWhitespace() {
-    char c;
+optional<Token> Tokenizer::skipWhitespace() {
     while (true) {
-        if (!inputStream.get(c)) {
-            return; // No more input
-        }
-        // Treat '\r' as whitespace
-        if (c == '\r' || isspace(toUnsignedChar(c))) {
-            if (c == '\n') {
-                lineNum++;
+        // Whole whitespace run (includes '\r')
+        _cur = spaceRunEnd(_cur, _end);
+        // Comments are treated as whitespace
+        if (_cur + 1 < _end && _cur[0] == '/' && (_cur[1] == '/' || _cur[1] == '*')) {
+            const char* commentStart = _cur;
+            uint32_t commentOffset = offsetOf(_cur);
+            if (!skipComment()) {
+                // Reached end-of-file inside a block comment. A streamed
+                // window has moved on, but the text is always the same.
+                return Token(Type::ERROR_UNCLOSED_COMMENT, _input ? "/*" : commentStart,
+                             SourceSpan{ _file, commentOffset, 2 });
             }
         }
-        else { // Not whitespace, put back
-            inputStream.unget();
-            return;
+        else { // Not whitespace
+            return nullopt;
         }
     }
 }
 
-Token Tokenizer::getToken() {
-    // Use any former pending tokens
-    if (!_pendingTokens.empty()) {
-        Token t = _pendingTokens.front();
-        _pendingTokens.pop_front();
-        return t;
-    }
-
-    skipWhitespace();
-    char c;
-
-    //Case for End of File
-    if (!inputStream.get(c)) {
-        return Token(Type::END_OF_FILE, "", lineNum);
-    }
-    // Case for entering a string ("")
-    if (c == '"') {
-        buildDoubleQuoteTokens();
-        if (!_pendingTokens.empty()) {
-            Token t = _pendingTokens.front();
-            _pendingTokens.pop_front();
-            return t;
+bool Tokenizer::skipComment() {
+    _cur++;
+    // Line comment, up to the '\n'
+    if (*_cur++ == '/') {
+        _cur = scanUntil(_cur, _end, ByteSet('\n'));
+        return true;
+    }
+    // Block comment, only '*' needs a closer look
+    while (true) {
+        _cur = scanUntil(_cur, _end, ByteSet('*'));
+        if (_cur == _end) {
+            if (refill(_cur)) {
+                continue;
+            }
+            return false;
         }
-        return Token(Type::END_OF_FILE, "", lineNum);
-    }
-    // Case for entering character literal ('')
-    if (c == '\'') {
-        buildSingleQuoteTokens();
-        if (!_pendingTokens.empty()) {
-            Token t = _pendingTokens.front();
-            _pendingTokens.pop_front();
-            return t;
+        _cur++;
+        if (_cur < _end && *_cur == '/') {
+            _cur++;
+            return true;
         }
-        return Token(Type::END_OF_FILE, "", lineNum);
-    }
-    // Case for letters (Includes '_')
-    if (isalpha(toUnsignedChar(c)) || c == '_') {
-        return readIdentifierOrKeyword(c);
-    }
-    // Case for digits
-    if (isdigit(toUnsignedChar(c))) {
-        return readNumber(c);
     }
-    // Case for punctuation (Ex: ! for not, ? for turnary operator)
-    if (ispunct(toUnsignedChar(c))) {
-        return readOperator(c);
-    }
-    // Else unknown
-    return Token(Type::ERROR_INVALID_CHAR, string(1, c), lineNum);
 }
 
-void Tokenizer::buildDoubleQuoteTokens() {
-    _pendingTokens.push_back(Token(Type::DOUBLE_QUOTE, "\"", lineNum));
-    std::string content;
-    char c;
-    bool escape = false;
+bool Tokenizer::refill(const char* &keep) {
+    if (!_input) {
+        return false;
+    }
+    size_t cur = _cur - keep;
+    size_t scanned = _end - keep;
+    bool more;
     while (true) {
-        if (!inputStream.get(c)) {
-            // End of file before closing quote
-            _pendingTokens.push_back(Token(Type::ERROR_UNCLOSED_STRING, content, lineNum));
-            return;
-        }
-        if (escape) {
-            // Add escaped character and reset flag
-            content.push_back(c);
-            escape = false;
-            continue;
-        }
-        if (c == '\\') {
-            // Escape next character
-            escape = true;
-            content.push_back(c);
-            continue;
-        }
-        if (c == '"') {
-            // Found unescaped closing quote
+        size_t read = _input->end() - keep;
+        if (!(more = _input->readMore(keep))) {
             break;
         }
-        if (c == '\n' || c == '\r') {
-            // Newline without closing quote
-            inputStream.unget(); // Return newline for proper line counting
-            _pendingTokens.push_back(Token(Type::ERROR_UNCLOSED_STRING, content, lineNum));
-            return;
+        keep = _input->begin();
+        // Lines are indexed as the stream goes by
+        sourceMap().lines(_file).appendText(keep + read, _input->end(),
+                                             static_cast<uint32_t>(_input->position() + read));
+        // Bytes before scanned hold no newline, only the new block is searched
+        const void* newline = memrchr(keep + scanned, '\n', _input->end() - keep - scanned);
+        if (newline) {
+            _end = static_cast<const char*>(newline) + 1;
+            break;
         }
-        content.push_back(c);
     }
-    _pendingTokens.push_back(Token(Type::STRING, content, lineNum));
-    _pendingTokens.push_back(Token(Type::DOUBLE_QUOTE, "\"", lineNum));
+    // The window slides even when nothing more was read
+    _base = keep = _input->begin();
+    _baseOffset = _input->position();
+    _cur = _base + cur;
+    if (!more) {
+        // The last line may lack a newline
+        _end = _input->end();
+    }
+    return size_t(_end - _base) > scanned;
 }
 
-void Tokenizer::buildSingleQuoteTokens() {
-    _pendingTokens.push_back(Token(Type::SINGLE_QUOTE, "\'", lineNum));
-    std::string content;
-    char c;
-    bool escape = false;
-    while (true) {
-        if (!inputStream.get(c)) {
-            _pendingTokens.push_back(Token(Type::ERROR_UNCLOSED_CHAR, content, lineNum));
-            return;
-        }
-        if (escape) {
-            content.push_back(c);
-            escape = false;
-            continue;
-        }
-        if (c == '\\') {
-            escape = true;
-            content.push_back(c);
-            continue;
-        }
-        if (c == '\'') {
-            break; // Valid closing quote
-        }
-        if (c == '\n' || c == '\r') {
-            inputStream.unget(); // Return newline for proper line counting
-            _pendingTokens.push_back(Token(Type::ERROR_UNCLOSED_CHAR, content, lineNum));
-            return;
-        }
-        content.push_back(c);
-    }
-    _pendingTokens.push_back(Token(Type::STRING, content, lineNum));
-    _pendingTokens.push_back(Token(Type::SINGLE_QUOTE, "\'", lineNum));
+Token Tokenizer::makeToken(Type type, const char* start, const char* end,
+                           NameId nameId, LiteralId literal) {
+    SourceSpan span{ _file, offsetOf(start), static_cast<uint32_t>(end - start) };
+    if (_input) {
+        string_view text = _streamText.spelling(_streamText.intern(string_view(start, end - start)));
+        return Token(type, text.data(), span, nameId, literal);
+    }
+    return Token(type, start, span, nameId, literal);
 }
 
-Token Tokenizer::readIdentifierOrKeyword(char firstChar) {
-    std::string inputIden(1, firstChar);
-    char c;
-    while (inputStream.get(c)) {
-        if (std::isalnum(toUnsignedChar(c)) || c == '_') {
-            inputIden.push_back(c);
-        } else {
-            inputStream.unget();
-            break;
-        }
-    }
-    // Specific Identifiers
-    // Check for reserved keywords
-    if (inputIden == "return")
-        return Token(Type::RETURN_KEYWORD, inputIden, lineNum);
-    if (inputIden == "TRUE")
-        return Token(Type::BOOLEAN_TRUE, inputIden, lineNum);
-    if (inputIden == "FALSE")
-        return Token(Type::BOOLEAN_FALSE, inputIden, lineNum);
-    if (inputIden == "char")
-        return Token(Type::CHAR, inputIden, lineNum);
-    if (inputIden == "bool")
-        return Token(Type::BOOL, inputIden, lineNum);
-    if (inputIden == "int")
-        return Token(Type::INT, inputIden, lineNum);
-    if (inputIden == "getchar")
-        return Token(Type::GETCHAR, inputIden, lineNum);
-    if (inputIden == "void")
-        return Token(Type::VOID, inputIden, lineNum);
-    if (inputIden == "sizeof")
-        return Token(Type::SIZEOF, inputIden, lineNum);
-    if (inputIden == "if")
-        return Token(Type::IF, inputIden, lineNum);
-    if (inputIden == "else")
-        return Token(Type::ELSE, inputIden, lineNum);
-    if (inputIden == "while")
-        return Token(Type::WHILE, inputIden, lineNum);
-    if (inputIden == "for")
-        return Token(Type::FOR, inputIden, lineNum);
-    if (inputIden == "printf")
-        return Token(Type::PRINTF, inputIden, lineNum);
-    if (inputIden == "function")
-         return Token(Type::FUNCTION, inputIden, lineNum);
-    if (inputIden == "procedure")
-        return Token(Type::PROCEDURE, inputIden, lineNum);
-    return Token(Type::IDENTIFIER, inputIden, lineNum);
+Token Tokenizer::getToken() {
+    _stream.next();
+    return _stream.value();
 }
 
-Token Tokenizer::readNumber(char firstChar) {
-    std::string inputNum(1, firstChar);
-    char c;
-    while (inputStream.get(c)) {
-        if (std::isdigit(toUnsignedChar(c))) {
-            inputNum.push_back(c);
-        }
-        else if (std::isalpha(toUnsignedChar(c))) {
-            //Error Case
-            inputNum.push_back(c);
-            return Token(Type::ERROR_INVALID_INT, inputNum, lineNum);
+Generator<Token> Tokenizer::scan() {
+    // Never finishes, at the end of the source every pass yields END_OF_FILE
+    while (true) {
+        if (optional<Token> unclosed = skipWhitespace()) {
+            co_yield *unclosed;
+            continue;
         }
-        else {
-            inputStream.unget();
-            break;
+        // Streamed input: everything up to here is consumed
+        if (_cur == _end && refill(_cur)) {
+            continue;
         }
-    }
-    return Token(Type::INTEGER, inputNum, lineNum);
-}
 
-Token Tokenizer::readNegativeNumber() {
-    std::string inputNum("-");
-    char c;
-    // read char after '-'
-    if (!inputStream.get(c)) {
-        // No input
-        return Token(Type::MINUS, "-", lineNum);
-    }
-    // Case for non-digit
-    if (!std::isdigit(toUnsignedChar(c))) {
-        inputStream.unget();
-        return Token(Type::MINUS, "-", lineNum);
-    }
-    // Case for digits
-    inputNum.push_back(c);
-    while (inputStream.get(c)) {
-        if (std::isdigit(toUnsignedChar(c))) {
-            inputNum.push_back(c);
+        // Drive the DFA from the start state until it accepts a token
+        const char* start = _cur;
+        unsigned char state = LS_START;
+        LexAction action;
+        while (true) {
+            unsigned char cls = _cur < _end ? lexClassTable[static_cast<unsigned char>(*_cur)] : static_cast<unsigned char>(LC_EOF);
+            action = lexTable[state][cls];
+            _cur += action.consume;
+            if (action.accept) {
+                break;
+            }
+            state = action.next;
+            // Identifier and number states loop on themselves, take the whole run at once
+            if (state == LS_IDENTIFIER) {
+                _cur = identRunEnd(_cur, _end);
+            } else if (state == LS_NUMBER) {
+                _cur = digitRunEnd(_cur, _end);
+            }
         }
-        else if (std::isalpha(toUnsignedChar(c))) {
-            //Error Case
-            inputNum.push_back(c);
-            return Token(Type::ERROR_INVALID_INT, inputNum, lineNum);
+        Type type = static_cast<Type>(action.type);
+        std::string_view text(start, _cur - start);
+        // Case for entering a string ("") or character literal (''): the
+        // opening quote, the contents (or an error) and the closing quote
+        if (type == Type::DOUBLE_QUOTE || type == Type::SINGLE_QUOTE) {
+            bool isString = type == Type::DOUBLE_QUOTE;
+            _atTokenStart = false;
+            co_yield makeToken(type, start, _cur);
+            // Content is the source text between the quotes, escapes included
+            const char* contents = _cur;
+            if (!skipQuoted(*start, contents)) {
+                _atTokenStart = true;
+                co_yield makeToken(isString ? Type::ERROR_UNCLOSED_STRING : Type::ERROR_UNCLOSED_CHAR,
+                                   contents, _cur);
+                continue;
+            }
+            // Contents are interned too, printf arguments are looked up by name
+            string_view raw(contents, _cur - contents);
+            NameId nameId = _names->intern(raw);
+            LiteralId literal = isString ? _literals->addString(raw) : _literals->addCharacter(raw);
+            co_yield makeToken(Type::STRING, contents, _cur, nameId, literal);
+            _cur++;
+            _atTokenStart = true;
+            co_yield makeToken(type, _cur - 1, _cur);
+            continue;
         }
-        else {
-            inputStream.unget();
-            break;
+        // Reserved keywords are found with a single perfect hash probe, every
+        // word (keyword or not) is interned so later phases compare ids
+        if (type == Type::IDENTIFIER) {
+            type = lookupKeyword(text);
+            co_yield makeToken(type, start, _cur, _names->intern(text));
+            continue;
         }
+        // Integers are parsed here once, later phases read the pooled value
+        if (type == Type::INTEGER) {
+            LiteralId literal = _literals->addInteger(text);
+            if (literal == NO_LITERAL) {
+                type = Type::ERROR_INTEGER_OVERFLOW;
+            }
+            co_yield makeToken(type, start, _cur, NO_NAME, literal);
+            continue;
+        }
+        co_yield makeToken(type, start, _cur);
     }
-    return Token(Type::INTEGER, inputNum, lineNum);
 }
 
-Token Tokenizer::readOperator(char firstChar) {
-    std::string inputOp(1, firstChar);
-    char c;
-    if (inputStream.get(c)) {
-        if (c == '\r') {
-            inputStream.unget();
-        } else {
-            //Two character operators
-            inputOp.push_back(c);
-            if (inputOp == "==") return Token(Type::BOOLEAN_EQUAL, inputOp, lineNum);
-            if (inputOp == "!=") return Token(Type::BOOLEAN_NOT_EQUAL, inputOp, lineNum);
-            if (inputOp == "<=") return Token(Type::LT_EQUAL, inputOp, lineNum);
-            if (inputOp == ">=") return Token(Type::GT_EQUAL, inputOp, lineNum);
-            if (inputOp == "&&") return Token(Type::BOOLEAN_AND, inputOp, lineNum);
-            if (inputOp == "||") return Token(Type::BOOLEAN_OR, inputOp, lineNum);
-            inputStream.unget();
-            inputOp.pop_back();
-        }
-    }
-    // Single-character operators
-    switch (firstChar) {
-        case '-': {
-            if (std::isdigit(toUnsignedChar(inputStream.peek()))) {
-                return readNegativeNumber();
-            }
-            else {
-                return Token(Type::MINUS, "-", lineNum);
+bool Tokenizer::skipQuoted(char quote, const char* &contents) {
+    while (true) {
+        _cur = scanUntil(_cur, _end, ByteSet('\\', quote, '\n', '\r'));
+        if (_cur == _end) {
+            // Streamed input: an escaped newline continues in the next window
+            if (refill(contents)) {
+                continue;
             }
+            // End of file before closing quote
+            return false;
+        }
+        char c = *_cur;
+        if (c == '\\') {
+            // Escape next character
+            _cur += (_cur + 1 < _end) ? 2 : 1;
+            continue;
         }
-        case '=':  return Token(Type::ASSIGNMENT_OPERATOR, "=", lineNum);
-        case '!':  return Token(Type::BOOLEAN_NOT, "!", lineNum);
-        case '+':  return Token(Type::PLUS, "+", lineNum);
-        case '*':  return Token(Type::ASTERISK, "*", lineNum);
-        case '/':  return Token(Type::DIVIDE, "/", lineNum);
-        case '%':  return Token(Type::MODULO, "%", lineNum);
-        case '<':  return Token(Type::LT, "<", lineNum);
-        case '>':  return Token(Type::GT, ">", lineNum);
-        case ';':  return Token(Type::SEMICOLON, ";", lineNum);
-        case ',':  return Token(Type::COMMA, ",", lineNum);
-        case '{':  return Token(Type::L_BRACE, "{", lineNum);
-        case '}':  return Token(Type::R_BRACE, "}", lineNum);
-        case '(':  return Token(Type::L_PAREN, "(", lineNum);
-        case ')':  return Token(Type::R_PAREN, ")", lineNum);
-        case '[':  return Token(Type::L_BRACKET, "[", lineNum);
-        case ']':  return Token(Type::R_BRACKET, "]", lineNum);
-        default:
-            return Token(Type::ERROR_INVALID_OPERATOR, std::string(1, firstChar), lineNum);
+        // Unescaped closing quote, or a newline that ends the literal
+        return c == quote;
     }
 }
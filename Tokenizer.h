@@ -12,32 +12,83 @@
 #define TOKENIZER_H
 
 #include <string>
-#include <fstream>
-#include <deque>
+#include <memory>
+#include <optional>
+#include "Generator.h"
 #include "Token.h"
+#include "SourceBuffer.h"
+#include "InputStream.h"
 
+// Tokens returned by getToken() view the tokenizer's source buffer, so the
+// tokenizer has to outlive them. The scan runs as a coroutine that yields one
+// token at a time; the tokenizer must not be moved once created.
 class Tokenizer {
 public:
-    explicit Tokenizer(const std::string &inputFile);
+    // "-" streams standard input instead of mapping a file. Words are
+    // interned into names and literal values go to literals.
+    explicit Tokenizer(const std::string &inputFile, NamePool &names = namePool(),
+                       LiteralPool &literals = literalPool());
+    // Tokenize a buffer owned by the caller from begin (a token boundary) up
+    // to end. Spans are in file with offsets relative to base, words are
+    // interned into names and literal values go to literals.
+    Tokenizer(const char* base, const char* begin, const char* end, FileId file,
+              NamePool &names, LiteralPool &literals);
+    Tokenizer(const Tokenizer &) = delete;
+    Tokenizer &operator=(const Tokenizer &) = delete;
     Token getToken();
+    // The token stream getToken() pulls from, for consumers that want to
+    // pull tokens lazily themselves. It repeats END_OF_FILE at the end.
+    Generator<Token> &tokens() { return _stream; }
+    // True when the next getToken() starts scanning a new token, false while
+    // the rest of a quoted literal is still to come
+    bool atTokenStart() const { return _atTokenStart; }
+    FileId file() const { return _file; }
+    // False if the input file could not be opened, there are no tokens then
+    bool isOpen() const { return _source ? _source->isOpen() : true; }
+    // The whole source, unless it is streamed
+    bool isStreamed() const { return _input != nullptr; }
+    const char* sourceBegin() const { return _base; }
+    const char* sourceEnd() const { return _end; }
 
 private:
-    std::ifstream inputStream;
-    std::ofstream outputStream;
-    int lineNum = 1;
-    std::deque<Token> _pendingTokens;
+    // Only set when the tokenizer opened the file itself
+    std::unique_ptr<SourceBuffer> _source;
+    // Only set for streamed input. The scan window then ends after a newline,
+    // so only comments and strings with escaped newlines cross a refill.
+    std::unique_ptr<InputStream> _input;
+    // Token text of streamed input, which does not stay in the window
+    NamePool _streamText;
+    const char* _base;
+    // Scan cursor into the source
+    const char* _cur;
+    const char* _end;
+    FileId _file;
+    // Stream offset of _base, 0 unless the input is streamed
+    size_t _baseOffset = 0;
+    NamePool* _names;
+    LiteralPool* _literals;
+    bool _atTokenStart = true;
+    Generator<Token> _stream;
 
-    // Skip whitespace (includes '\r', '\n', ...)
-    void skipWhitespace();
-    // Helpers for token types
-    void buildDoubleQuoteTokens();
-    void buildSingleQuoteTokens();
-    Token readIdentifierOrKeyword(char firstChar);
-    Token readNumber(char firstChar);
-    Token readOperator(char firstChar);
-    Token readNegativeNumber();
-    //Cast helper
-    static unsigned char toUnsignedChar(char c);
+    // Slide the streamed window so it starts at keep (which is moved along)
+    // and read up to the next newline, false when there is nothing more
+    bool refill(const char* &keep);
+    uint32_t offsetOf(const char* p) const { return static_cast<uint32_t>(_baseOffset + (p - _base)); }
+    // Token over the source text [start, end)
+    Token makeToken(Type type, const char* start, const char* end,
+                    NameId nameId = NO_NAME, LiteralId literal = NO_LITERAL);
+    // The scanning loop, yields every token as soon as it is recognized
+    Generator<Token> scan();
+    // Skip whitespace (includes '\r', '\n', ...) and comments, returns the
+    // error token of a block comment left open at end-of-file
+    std::optional<Token> skipWhitespace();
+    // Skip a line or block comment, false if the block comment is unterminated
+    bool skipComment();
+    // Move past the contents of a quoted literal to its closing quote, false
+    // if the line or file ends first. contents follows the window on refills.
+    // The tokens of the literal are yielded by scan(), the rest come from the
+    // DFA in LexTable.h
+    bool skipQuoted(char quote, const char* &contents);
 
 };
 
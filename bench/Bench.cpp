@@ -0,0 +1,423 @@
+/** ***************************************************************************
+ * @remark Benchmarks of the front-end phases over generated inputs. Each    *
+ *          subcommand times one phase (best of several runs) and prints    *
+ *          its throughput, see usage() for the list. `make bench` builds   *
+ *          this with -O2, generates the inputs and runs all of them.       *
+ *                                                                            *
+ * @file  Bench.cpp                                                           *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ByteScan.h"
+#include "IncrementalTokenizer.h"
+#include "LiteralPool.h"
+#include "NamePool.h"
+#include "NodeArena.h"
+#include "Parser.h"
+#include "ParallelTokenizer.h"
+#include "SourceMap.h"
+#include "Tokenizer.h"
+#include "IfstreamTokenizer.h"
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// Every timing is the best of this many runs
+static constexpr int RUNS = 5;
+
+// Best time of RUNS runs of work, in seconds
+template <typename Work>
+static double best(Work work) {
+    double fastest = 1e30;
+    for (int run = 0; run < RUNS; run++) {
+        Clock::time_point start = Clock::now();
+        work();
+        fastest = min(fastest, chrono::duration<double>(Clock::now() - start).count());
+    }
+    return fastest;
+}
+
+// N independent functions with comments, strings and char literals, then
+// main: the shape of the generated programs the front-end is tuned for
+static string generateFunctions(size_t n) {
+    ostringstream out;
+    out << "// generated\nint g_count;\n";
+    for (size_t i = 0; i < n; i++) {
+        out << "// ***********************************************\n"
+               "// * helper " << i << " computes something interesting      *\n"
+               "// ***********************************************\n"
+               "function int f" << i << " (int a, int b)\n"
+               "{\n"
+               "  int result;\n"
+               "  int idx;\n"
+               "  char label[16];\n"
+               "\n"
+               "  /* block comment for " << i << " */\n"
+               "  result = a * 2 + b - " << i % 97 << ";\n"
+               "  idx = 0;\n"
+               "  while (idx < 10)\n"
+               "  {\n"
+               "    result = result + (idx % 3);\n"
+               "    idx = idx + 1;\n"
+               "  }\n"
+               "  if ((result % 2) == 0)\n"
+               "  {\n"
+               "    printf (\"even %d\\n\", result);\n"
+               "  }\n"
+               "  else\n"
+               "  {\n"
+               "    label[0] = 'x';\n"
+               "  }\n"
+               "  return result;\n"
+               "}\n"
+               "\n";
+    }
+    out << "procedure main (void)\n"
+           "{\n"
+           "  int x;\n"
+           "  x = 1;\n"
+           "  printf (\"%d\\n\", x);\n"
+           "}\n";
+    return out.str();
+}
+
+// main with N consecutive statements, one long sibling chain in the CST
+static string generateStatements(size_t n) {
+    string text = "procedure main (void)\n{\n  int x;\n  x = 0;\n";
+    for (size_t i = 0; i < n; i++) {
+        text += "  x = x + 1;\n";
+    }
+    return text + "}\n";
+}
+
+static bool readFile(const string &path, string &text) {
+    ifstream in(path, ios::binary);
+    if (!in) {
+        return false;
+    }
+    ostringstream contents;
+    contents << in.rdbuf();
+    text = contents.str();
+    return true;
+}
+
+static size_t countTokens(Tokenizer &tokenizer) {
+    size_t tokens = 1;
+    while (!tokenizer.getToken().isEndOfFile()) {
+        tokens++;
+    }
+    return tokens;
+}
+
+// One line of results, speedup over a baseline time if there is one
+static void printRate(const string &what, double amount, const string &unit, double seconds,
+                      double baseline = 0) {
+    cout << "  " << left << setw(24) << what << right << fixed << setprecision(1)
+         << setw(9) << seconds * 1000 << " ms  " << setw(8) << amount / seconds / 1e6 << " " << unit;
+    if (baseline > 0) {
+        cout << setprecision(2) << "  " << baseline / seconds << "x";
+    }
+    cout << "\n";
+}
+
+// Tokenizing through the old per-character ifstream reads against the
+// mapped SourceBuffer
+static void benchRead(const string &path) {
+    string text;
+    if (!readFile(path, text)) {
+        cerr << "bench: cannot read " << path << "\n";
+        exit(1);
+    }
+    size_t oldTokens = 0;
+    size_t tokens = 0;
+    double streamed = best([&] {
+        IfstreamTokenizer tokenizer(path);
+        oldTokens = 1;
+        while (!tokenizer.getToken().isEndOfFile()) {
+            oldTokens++;
+        }
+    });
+    double mapped = best([&] {
+        Tokenizer tokenizer(path);
+        tokens = countTokens(tokenizer);
+    });
+    if (tokens != oldTokens) {
+        cerr << "bench: " << tokens << " tokens, the ifstream tokenizer found " << oldTokens << "\n";
+        exit(1);
+    }
+    cout << "read " << path << " (" << fixed << setprecision(1) << text.size() / 1e6 << " MB, "
+         << tokens << " tokens)\n";
+    printRate("ifstream get/unget", text.size(), "MB/s", streamed);
+    printRate("mapped", text.size(), "MB/s", mapped, streamed);
+}
+
+// Tokenizing under each scan kernel, scalar being the byte-at-a-time loop
+// that used to skip comment bodies and literals
+static void benchComments(const string &path) {
+    string text;
+    if (!readFile(path, text)) {
+        cerr << "bench: cannot read " << path << "\n";
+        exit(1);
+    }
+    string detected = scanKernelName();
+    cout << "comments " << path << " (" << fixed << setprecision(1) << text.size() / 1e6
+         << " MB, detected kernel " << detected << ")\n";
+    double scalar = 0;
+    for (const char* kernel : { "scalar", "sse2", "avx2" }) {
+        if (!selectScanKernel(kernel)) {
+            continue;
+        }
+        double seconds = best([&] {
+            Tokenizer tokenizer(path);
+            countTokens(tokenizer);
+        });
+        if (scalar == 0) {
+            scalar = seconds;
+        }
+        printRate(kernel, text.size(), "MB/s", seconds, scalar);
+    }
+    selectScanKernel(detected.c_str());
+}
+
+// Tokenizing the whole file, in bytes and tokens per second
+static void benchTokenize(const string &path) {
+    string text;
+    if (!readFile(path, text)) {
+        cerr << "bench: cannot read " << path << "\n";
+        exit(1);
+    }
+    size_t tokens = 0;
+    double seconds = best([&] {
+        Tokenizer tokenizer(path);
+        tokens = countTokens(tokenizer);
+    });
+    cout << "tokenize " << path << " (" << fixed << setprecision(1) << text.size() / 1e6 << " MB, "
+         << tokens << " tokens)\n";
+    printRate("bytes", text.size(), "MB/s", seconds);
+    printRate("tokens", tokens, "M tokens/s", seconds);
+}
+
+// tokenizeParallel at 1, 2, 4 and 8 threads (and every core, if more).
+// The speedup is over one thread, and is only meaningful up to the number
+// of cores of the machine it runs on
+static void benchLexThreads(const string &path) {
+    string text;
+    if (!readFile(path, text)) {
+        cerr << "bench: cannot read " << path << "\n";
+        exit(1);
+    }
+    unsigned cores = max(thread::hardware_concurrency(), 1u);
+    cout << "lex-threads " << path << " (" << fixed << setprecision(1) << text.size() / 1e6 << " MB, "
+         << cores << " cores)\n";
+    vector<unsigned> counts = { 1, 2, 4, 8 };
+    if (cores > 8) {
+        counts.push_back(cores);
+    }
+    double serial = 0;
+    size_t serialTokens = 0;
+    for (unsigned threads : counts) {
+        size_t tokens = 0;
+        double seconds = best([&] {
+            Tokenizer tokenizer(path);
+            tokens = tokenizeParallel(tokenizer, threads).size();
+        });
+        if (threads == 1) {
+            serial = seconds;
+            serialTokens = tokens;
+        } else if (tokens != serialTokens) {
+            cerr << "bench: " << threads << " threads give " << tokens << " tokens, not " << serialTokens << "\n";
+            exit(1);
+        }
+        printRate(to_string(threads) + " threads", tokens, "M tokens/s", seconds, serial);
+    }
+}
+
+// One statement inserted halfway through the file: retokenize() against
+// lexing the whole edited file again
+static void benchEdit(const string &path) {
+    string text;
+    if (!readFile(path, text)) {
+        cerr << "bench: cannot read " << path << "\n";
+        exit(1);
+    }
+    const string statement = "  idx = idx + 1;\n";
+    uint32_t offset = text.find('\n', text.size() / 2) + 1;
+    string edited = text.substr(0, offset) + statement + text.substr(offset);
+    SourceEdit edit{ offset, 0, static_cast<uint32_t>(statement.size()) };
+
+    auto lexAll = [](const string &source) {
+        FileId file = sourceMap().addFile("<edit>");
+        sourceMap().lines(file).setText(source.data(), source.data() + source.size());
+        Tokenizer tokenizer(source.data(), source.data(), source.data() + source.size(), file, namePool(),
+                            literalPool());
+        vector<Token> tokens;
+        do {
+            tokens.push_back(tokenizer.getToken());
+        } while (!tokens.back().isEndOfFile());
+        return tokens;
+    };
+    vector<Token> original = lexAll(text);
+    vector<Token> tokens;
+    double full = best([&] { tokens = lexAll(edited); });
+    size_t fullCount = tokens.size();
+
+    double incremental = 1e30;
+    size_t relexed = 0;
+    for (int run = 0; run < RUNS; run++) {
+        tokens = original;
+        Clock::time_point start = Clock::now();
+        relexed = retokenize(tokens, edited.data(), edited.data() + edited.size(), edit);
+        incremental = min(incremental, chrono::duration<double>(Clock::now() - start).count());
+    }
+    if (tokens.size() != fullCount) {
+        cerr << "bench: the edit gives " << tokens.size() << " tokens, a full re-lex " << fullCount << "\n";
+        exit(1);
+    }
+    size_t lines = count(text.begin(), text.end(), '\n');
+    cout << "edit " << path << " (" << lines << " lines, one line inserted, " << relexed << " tokens re-lexed)\n";
+    printRate("full re-lex", edited.size(), "MB/s", full);
+    printRate("retokenize", edited.size(), "MB/s", incremental, full);
+}
+
+static Generator<Token> replay(const vector<Token> &tokens) {
+    for (const Token &token : tokens) {
+        co_yield token;
+    }
+}
+
+// All tokens of text, registered in sourceMap() as a file called name
+static vector<Token> lexText(const string &name, const string &text) {
+    FileId file = sourceMap().addFile(name);
+    sourceMap().lines(file).setText(text.data(), text.data() + text.size());
+    Tokenizer tokenizer(text.data(), text.data(), text.data() + text.size(), file, namePool(), literalPool());
+    vector<Token> tokens;
+    do {
+        tokens.push_back(tokenizer.getToken());
+    } while (!tokens.back().isEndOfFile());
+    return tokens;
+}
+
+static size_t countNodes(const Node* root) {
+    size_t nodes = 0;
+    vector<const Node*> pending{ root };
+    while (!pending.empty()) {
+        const Node* node = pending.back();
+        pending.pop_back();
+        for (; node != nullptr; node = node->rightSibling) {
+            nodes++;
+            if (node->leftChild != nullptr) {
+                pending.push_back(node->leftChild);
+            }
+        }
+    }
+    return nodes;
+}
+
+// parse() plus makeTerminalOnlyCST over pre-lexed tokens, with a plain
+// operator new per node as before the arena, then from the arena. The
+// per-node nodes are never freed, as they were not then, so keep the
+// input small.
+static void benchParse(const string &path) {
+    string text;
+    if (!readFile(path, text)) {
+        cerr << "bench: cannot read " << path << "\n";
+        exit(1);
+    }
+    vector<Token> lexed = lexText(path, text);
+
+    size_t nodes = 0;
+    size_t heapBytes = 0;
+    auto parseOnce = [&] {
+        TokenList tokens(replay(lexed));
+        size_t heapBefore = mallinfo2().uordblks;
+        Parser parser(tokens);
+        Node* cst = parser.parse();
+        Node* terminals = parser.makeTerminalOnlyCST(cst);
+        heapBytes = mallinfo2().uordblks - heapBefore;
+        nodes = countNodes(cst) + countNodes(terminals);
+    };
+    cout << "parse " << path << " (" << lexed.size() << " tokens)\n";
+    double baseline = 0;
+    for (bool heap : { true, false }) {
+        NodeArena::setHeapPerObject(heap);
+        double seconds = best(parseOnce);
+        printRate(heap ? "new per node" : "arena", nodes, "M nodes/s", seconds, baseline);
+        cout << "  " << setw(24) << "" << setprecision(1) << setw(9) << double(heapBytes) / nodes
+             << " heap bytes/node\n";
+        baseline = seconds;
+    }
+    NodeArena::setHeapPerObject(false);
+}
+
+// Parse time should grow linearly with the length of a statement list
+static void benchStatements(size_t most) {
+    cout << "statements (parse time per statement should stay flat)\n";
+    for (size_t n = most / 8; n <= most; n *= 2) {
+        string text = generateStatements(n);
+        vector<Token> lexed = lexText("<" + to_string(n) + " statements>", text);
+        double seconds = best([&] {
+            TokenList tokens(replay(lexed));
+            Parser parser(tokens);
+            parser.makeTerminalOnlyCST(parser.parse());
+        });
+        cout << "  " << left << setw(24) << (to_string(n) + " statements") << right << fixed
+             << setprecision(1) << setw(9) << seconds * 1000 << " ms  " << setw(8)
+             << seconds * 1e9 / n << " ns/statement\n";
+    }
+}
+
+static int usage(const char* program) {
+    cerr << "Usage: " << program << " generate functions|statements <N>\n"
+         << "       " << program << " read <file>\n"
+         << "       " << program << " comments <file>\n"
+         << "       " << program << " tokenize <file>\n"
+         << "       " << program << " lex-threads <file>\n"
+         << "       " << program << " edit <file>\n"
+         << "       " << program << " parse <file>\n"
+         << "       " << program << " statements [maxStatements]\n";
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        return usage(argv[0]);
+    }
+    string command = argv[1];
+    if (command == "generate" && argc == 4) {
+        string kind = argv[2];
+        size_t n = strtoul(argv[3], nullptr, 10);
+        if (kind != "functions" && kind != "statements") {
+            return usage(argv[0]);
+        }
+        cout << (kind == "functions" ? generateFunctions(n) : generateStatements(n));
+    } else if (command == "statements") {
+        benchStatements(argc > 2 ? strtoul(argv[2], nullptr, 10) : 200000);
+    } else if (argc < 3) {
+        return usage(argv[0]);
+    } else if (command == "read") {
+        benchRead(argv[2]);
+    } else if (command == "comments") {
+        benchComments(argv[2]);
+    } else if (command == "tokenize") {
+        benchTokenize(argv[2]);
+    } else if (command == "lex-threads") {
+        benchLexThreads(argv[2]);
+    } else if (command == "edit") {
+        benchEdit(argv[2]);
+    } else if (command == "parse") {
+        benchParse(argv[2]);
+    } else {
+        return usage(argv[0]);
+    }
+    return 0;
+}
@@ -0,0 +1,369 @@
+/** ***************************************************************************
+ * @remark The tokenizer as it was before the source buffer: it reads the    *
+ *          input through std::ifstream one get()/unget()/peek() at a time.  *
+ *          Kept only as the baseline the read benchmark compares against.   *
+ *                                                                            *
+ * @file  IfstreamTokenizer.cpp                                               *
+ *****************************************************************************/
+
+#include "IfstreamTokenizer.h"
+#include <iostream>
+#include <cctype>
+#include <cstdlib>
+
+IfstreamToken::IfstreamToken(Type t, const std::string &s, int l) : type(t), text(s), line(l) {}
+
+IfstreamTokenizer::IfstreamTokenizer(const std::string &inputFile) {
+    inputStream.open(inputFile);
+    if (!inputStream.is_open()) {
+        std::cerr << "Error: Could not open file " << inputFile << std::endl;
+        exit(1);
+    }
+}
+
+unsigned char IfstreamTokenizer::toUnsignedChar(char c) {
+    return static_cast<unsigned char>(c);
+}
+
+void IfstreamTokenizer::skipWhitespace() {
+    char c;
+    while (true) {
+        if (!inputStream.get(c)) {
+            return; // No more input
+        }
+        // Treat '\r' as whitespace
+        if (c == '\r' || isspace(toUnsignedChar(c))) {
+            if (c == '\n') {
+                lineNum++;
+            }
+        }
+        // Comments are treated as whitespace
+        else if (c == '/') {
+            int next = inputStream.peek();
+            if (next != '/' && next != '*') { // Division operator, put back
+                inputStream.clear();
+                inputStream.unget();
+                return;
+            }
+            if (!skipComment()) {
+                return;
+            }
+        }
+        else { // Not whitespace, put back
+            inputStream.unget();
+            return;
+        }
+    }
+}
+
+bool IfstreamTokenizer::skipComment() {
+    char c;
+    inputStream.get(c);
+    // Line comment, leave the '\n' for skipWhitespace to count
+    if (c == '/') {
+        while (inputStream.peek() != EOF && inputStream.peek() != '\n') {
+            inputStream.get(c);
+        }
+        return true;
+    }
+    // Block comment
+    int blockStart = lineNum;
+    while (inputStream.get(c)) {
+        if (c == '\n') {
+            lineNum++;
+        }
+        else if (c == '*' && inputStream.peek() == '/') {
+            inputStream.get(c);
+            return true;
+        }
+    }
+    // Reached end-of-file inside a block comment
+    _pendingTokens.push_back(IfstreamToken(Type::ERROR_UNCLOSED_COMMENT, "/*", blockStart));
+    return false;
+}
+
+IfstreamToken IfstreamTokenizer::getToken() {
+    // Use any former pending tokens
+    if (!_pendingTokens.empty()) {
+        IfstreamToken t = _pendingTokens.front();
+        _pendingTokens.pop_front();
+        return t;
+    }
+
+    skipWhitespace();
+    if (!_pendingTokens.empty()) {
+        IfstreamToken t = _pendingTokens.front();
+        _pendingTokens.pop_front();
+        return t;
+    }
+    char c;
+
+    //Case for End of File
+    if (!inputStream.get(c)) {
+        return IfstreamToken(Type::END_OF_FILE, "", lineNum);
+    }
+    // Case for entering a string ("")
+    if (c == '"') {
+        buildDoubleQuoteTokens();
+        if (!_pendingTokens.empty()) {
+            IfstreamToken t = _pendingTokens.front();
+            _pendingTokens.pop_front();
+            return t;
+        }
+        return IfstreamToken(Type::END_OF_FILE, "", lineNum);
+    }
+    // Case for entering character literal ('')
+    if (c == '\'') {
+        buildSingleQuoteTokens();
+        if (!_pendingTokens.empty()) {
+            IfstreamToken t = _pendingTokens.front();
+            _pendingTokens.pop_front();
+            return t;
+        }
+        return IfstreamToken(Type::END_OF_FILE, "", lineNum);
+    }
+    // Case for letters (Includes '_')
+    if (isalpha(toUnsignedChar(c)) || c == '_') {
+        return readIdentifierOrKeyword(c);
+    }
+    // Case for digits
+    if (isdigit(toUnsignedChar(c))) {
+        return readNumber(c);
+    }
+    // Case for punctuation (Ex: ! for not, ? for turnary operator)
+    if (ispunct(toUnsignedChar(c))) {
+        return readOperator(c);
+    }
+    // Else unknown
+    return IfstreamToken(Type::ERROR_INVALID_CHAR, string(1, c), lineNum);
+}
+
+void IfstreamTokenizer::buildDoubleQuoteTokens() {
+    _pendingTokens.push_back(IfstreamToken(Type::DOUBLE_QUOTE, "\"", lineNum));
+    std::string content;
+    char c;
+    bool escape = false;
+    while (true) {
+        if (!inputStream.get(c)) {
+            // End of file before closing quote
+            _pendingTokens.push_back(IfstreamToken(Type::ERROR_UNCLOSED_STRING, content, lineNum));
+            return;
+        }
+        if (escape) {
+            // Add escaped character and reset flag
+            content.push_back(c);
+            escape = false;
+            continue;
+        }
+        if (c == '\\') {
+            // Escape next character
+            escape = true;
+            content.push_back(c);
+            continue;
+        }
+        if (c == '"') {
+            // Found unescaped closing quote
+            break;
+        }
+        if (c == '\n' || c == '\r') {
+            // Newline without closing quote
+            inputStream.unget(); // Return newline for proper line counting
+            _pendingTokens.push_back(IfstreamToken(Type::ERROR_UNCLOSED_STRING, content, lineNum));
+            return;
+        }
+        content.push_back(c);
+    }
+    _pendingTokens.push_back(IfstreamToken(Type::STRING, content, lineNum));
+    _pendingTokens.push_back(IfstreamToken(Type::DOUBLE_QUOTE, "\"", lineNum));
+}
+
+void IfstreamTokenizer::buildSingleQuoteTokens() {
+    _pendingTokens.push_back(IfstreamToken(Type::SINGLE_QUOTE, "\'", lineNum));
+    std::string content;
+    char c;
+    bool escape = false;
+    while (true) {
+        if (!inputStream.get(c)) {
+            _pendingTokens.push_back(IfstreamToken(Type::ERROR_UNCLOSED_CHAR, content, lineNum));
+            return;
+        }
+        if (escape) {
+            content.push_back(c);
+            escape = false;
+            continue;
+        }
+        if (c == '\\') {
+            escape = true;
+            content.push_back(c);
+            continue;
+        }
+        if (c == '\'') {
+            break; // Valid closing quote
+        }
+        if (c == '\n' || c == '\r') {
+            inputStream.unget(); // Return newline for proper line counting
+            _pendingTokens.push_back(IfstreamToken(Type::ERROR_UNCLOSED_CHAR, content, lineNum));
+            return;
+        }
+        content.push_back(c);
+    }
+    _pendingTokens.push_back(IfstreamToken(Type::STRING, content, lineNum));
+    _pendingTokens.push_back(IfstreamToken(Type::SINGLE_QUOTE, "\'", lineNum));
+}
+
+IfstreamToken IfstreamTokenizer::readIdentifierOrKeyword(char firstChar) {
+    std::string inputIden(1, firstChar);
+    char c;
+    while (inputStream.get(c)) {
+        if (std::isalnum(toUnsignedChar(c)) || c == '_') {
+            inputIden.push_back(c);
+        } else {
+            inputStream.unget();
+            break;
+        }
+    }
+    // Specific Identifiers
+    // Check for reserved keywords
+    if (inputIden == "return")
+        return IfstreamToken(Type::RETURN_KEYWORD, inputIden, lineNum);
+    if (inputIden == "TRUE")
+        return IfstreamToken(Type::BOOLEAN_TRUE, inputIden, lineNum);
+    if (inputIden == "FALSE")
+        return IfstreamToken(Type::BOOLEAN_FALSE, inputIden, lineNum);
+    if (inputIden == "char")
+        return IfstreamToken(Type::CHAR, inputIden, lineNum);
+    if (inputIden == "bool")
+        return IfstreamToken(Type::BOOL, inputIden, lineNum);
+    if (inputIden == "int")
+        return IfstreamToken(Type::INT, inputIden, lineNum);
+    if (inputIden == "getchar")
+        return IfstreamToken(Type::GETCHAR, inputIden, lineNum);
+    if (inputIden == "void")
+        return IfstreamToken(Type::VOID, inputIden, lineNum);
+    if (inputIden == "sizeof")
+        return IfstreamToken(Type::SIZEOF, inputIden, lineNum);
+    if (inputIden == "if")
+        return IfstreamToken(Type::IF, inputIden, lineNum);
+    if (inputIden == "else")
+        return IfstreamToken(Type::ELSE, inputIden, lineNum);
+    if (inputIden == "while")
+        return IfstreamToken(Type::WHILE, inputIden, lineNum);
+    if (inputIden == "for")
+        return IfstreamToken(Type::FOR, inputIden, lineNum);
+    if (inputIden == "printf")
+        return IfstreamToken(Type::PRINTF, inputIden, lineNum);
+    if (inputIden == "function")
+         return IfstreamToken(Type::FUNCTION, inputIden, lineNum);
+    if (inputIden == "procedure")
+        return IfstreamToken(Type::PROCEDURE, inputIden, lineNum);
+    return IfstreamToken(Type::IDENTIFIER, inputIden, lineNum);
+}
+
+IfstreamToken IfstreamTokenizer::readNumber(char firstChar) {
+    std::string inputNum(1, firstChar);
+    char c;
+    while (inputStream.get(c)) {
+        if (std::isdigit(toUnsignedChar(c))) {
+            inputNum.push_back(c);
+        }
+        else if (std::isalpha(toUnsignedChar(c))) {
+            //Error Case
+            inputNum.push_back(c);
+            return IfstreamToken(Type::ERROR_INVALID_INT, inputNum, lineNum);
+        }
+        else {
+            inputStream.unget();
+            break;
+        }
+    }
+    return IfstreamToken(Type::INTEGER, inputNum, lineNum);
+}
+
+IfstreamToken IfstreamTokenizer::readNegativeNumber() {
+    std::string inputNum("-");
+    char c;
+    // read char after '-'
+    if (!inputStream.get(c)) {
+        // No input
+        return IfstreamToken(Type::MINUS, "-", lineNum);
+    }
+    // Case for non-digit
+    if (!std::isdigit(toUnsignedChar(c))) {
+        inputStream.unget();
+        return IfstreamToken(Type::MINUS, "-", lineNum);
+    }
+    // Case for digits
+    inputNum.push_back(c);
+    while (inputStream.get(c)) {
+        if (std::isdigit(toUnsignedChar(c))) {
+            inputNum.push_back(c);
+        }
+        else if (std::isalpha(toUnsignedChar(c))) {
+            //Error Case
+            inputNum.push_back(c);
+            return IfstreamToken(Type::ERROR_INVALID_INT, inputNum, lineNum);
+        }
+        else {
+            inputStream.unget();
+            break;
+        }
+    }
+    return IfstreamToken(Type::INTEGER, inputNum, lineNum);
+}
+
+IfstreamToken IfstreamTokenizer::readOperator(char firstChar) {
+    std::string inputOp(1, firstChar);
+    char c;
+    if (inputStream.get(c)) {
+        if (c == '\r') {
+            inputStream.unget();
+        } else {
+            //Two character operators
+            inputOp.push_back(c);
+            if (inputOp == "==") return IfstreamToken(Type::BOOLEAN_EQUAL, inputOp, lineNum);
+            if (inputOp == "!=") return IfstreamToken(Type::BOOLEAN_NOT_EQUAL, inputOp, lineNum);
+            if (inputOp == "<=") return IfstreamToken(Type::LT_EQUAL, inputOp, lineNum);
+            if (inputOp == ">=") return IfstreamToken(Type::GT_EQUAL, inputOp, lineNum);
+            if (inputOp == "&&") return IfstreamToken(Type::BOOLEAN_AND, inputOp, lineNum);
+            if (inputOp == "||") return IfstreamToken(Type::BOOLEAN_OR, inputOp, lineNum);
+            inputStream.unget();
+            inputOp.pop_back();
+        }
+    }
+    // Single-character operators
+    switch (firstChar) {
+        case '-': {
+            if (std::isdigit(toUnsignedChar(inputStream.peek()))) {
+                return readNegativeNumber();
+            }
+            else {
+                return IfstreamToken(Type::MINUS, "-", lineNum);
+            }
+        }
+        case '=':  return IfstreamToken(Type::ASSIGNMENT_OPERATOR, "=", lineNum);
+        case '!':  return IfstreamToken(Type::BOOLEAN_NOT, "!", lineNum);
+        case '+':  return IfstreamToken(Type::PLUS, "+", lineNum);
+        case '*': {
+            // Stray end of block comment
+            if (inputStream.peek() == '/') {
+                inputStream.get(c);
+                return IfstreamToken(Type::ERROR_UNCLOSED_COMMENT, "*/", lineNum);
+            }
+            return IfstreamToken(Type::ASTERISK, "*", lineNum);
+        }
+        case '/':  return IfstreamToken(Type::DIVIDE, "/", lineNum);
+        case '%':  return IfstreamToken(Type::MODULO, "%", lineNum);
+        case '<':  return IfstreamToken(Type::LT, "<", lineNum);
+        case '>':  return IfstreamToken(Type::GT, ">", lineNum);
+        case ';':  return IfstreamToken(Type::SEMICOLON, ";", lineNum);
+        case ',':  return IfstreamToken(Type::COMMA, ",", lineNum);
+        case '{':  return IfstreamToken(Type::L_BRACE, "{", lineNum);
+        case '}':  return IfstreamToken(Type::R_BRACE, "}", lineNum);
+        case '(':  return IfstreamToken(Type::L_PAREN, "(", lineNum);
+        case ')':  return IfstreamToken(Type::R_PAREN, ")", lineNum);
+        case '[':  return IfstreamToken(Type::L_BRACKET, "[", lineNum);
+        case ']':  return IfstreamToken(Type::R_BRACKET, "]", lineNum);
+        default:
+            return IfstreamToken(Type::ERROR_INVALID_OPERATOR, std::string(1, firstChar), lineNum);
+    }
+}
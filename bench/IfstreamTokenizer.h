@@ -0,0 +1,53 @@
+/** ***************************************************************************
+ * @remark The tokenizer as it was before the source buffer: it reads the    *
+ *          input through std::ifstream one get()/unget()/peek() at a time.  *
+ *          Kept only as the baseline the read benchmark compares against.   *
+ *                                                                            *
+ * @file  IfstreamTokenizer.h                                                 *
+ *****************************************************************************/
+
+#ifndef IFSTREAMTOKENIZER_H
+#define IFSTREAMTOKENIZER_H
+
+#include <string>
+#include <fstream>
+#include <deque>
+#include "Token.h"
+
+// Token as the old tokenizer made it, owning a copy of its text
+struct IfstreamToken {
+    Type type;
+    std::string text;
+    int line;
+
+    IfstreamToken(Type t, const std::string &s, int l);
+    bool isEndOfFile() const { return type == Type::END_OF_FILE; }
+};
+
+class IfstreamTokenizer {
+public:
+    explicit IfstreamTokenizer(const std::string &inputFile);
+    IfstreamToken getToken();
+
+private:
+    std::ifstream inputStream;
+    int lineNum = 1;
+    std::deque<IfstreamToken> _pendingTokens;
+
+    // Skip whitespace (includes '\r', '\n', ...) and comments
+    void skipWhitespace();
+    // Skip a line or block comment, false if the block comment is unterminated
+    bool skipComment();
+    // Helpers for token types
+    void buildDoubleQuoteTokens();
+    void buildSingleQuoteTokens();
+    IfstreamToken readIdentifierOrKeyword(char firstChar);
+    IfstreamToken readNumber(char firstChar);
+    IfstreamToken readOperator(char firstChar);
+    IfstreamToken readNegativeNumber();
+    //Cast helper
+    static unsigned char toUnsignedChar(char c);
+
+};
+
+#endif // IFSTREAMTOKENIZER_H
@@ -8,82 +8,138 @@
 
 #include <iostream>
 #include <fstream>
+#include <optional>
+#include <thread>
+#include "Generator.h"
 #include "Tokenizer.h"
+#include "ParallelTokenizer.h"
+#include "TokenPipeline.h"
 #include "TokenList.h"
 #include "Parser.h"
 #include "Node.h"
 #include "SymbolTable.h"
 #include "AST.hpp"
 #include "ASTNode.hpp"
+#include "Diagnostics.h"
 
-void IgnoreComments(const string &inputFile, const string &preprocessedFile);
+// Report a tokenizer error
+static void reportTokenError(const Token &token, Diagnostics &diagnostics) {
+    string errorMsg;
+    // create tokenizer error message
+    switch (token.getType()) {
+        case Type::ERROR_INVALID_INT:
+            errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": invalid integer";
+            break;
+        case Type::ERROR_UNCLOSED_STRING:
+            errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": unterminated string quote";
+            break;
+        case Type::ERROR_UNCLOSED_CHAR:
+            errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": unclosed character literal";
+            break;
+        case Type::ERROR_INVALID_CHAR:
+            errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": invalid character";
+        break;
+        case Type::ERROR_INVALID_OPERATOR:
+            errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": invalid operator";
+        break;
+        case Type::ERROR_INVALID_IDENTIFIER:
+            errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": invalid identifier";
+        break;
+        case Type::ERROR_INTEGER_OVERFLOW:
+            errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": integer literal out of range";
+        break;
+        case Type::ERROR_UNCLOSED_COMMENT:
+            diagnostics.report(DiagnosticKind::COMMENT, token.getSpan(),
+                               "ERROR: Program contains C-style, unterminated comment on line " +
+                               std::to_string(token.getLine()));
+            return;
+        default:
+            errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": unknown error";
+        break;
+    }
+    diagnostics.report(DiagnosticKind::LEXICAL, token.getSpan(), errorMsg);
+}
 
-int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <inputFile>\n";
-        return 1;
+// Tokens for the parser up to END_OF_FILE. The first tokenizer error is
+// reported and ends the input there.
+static Generator<Token> checkedTokens(Generator<Token> &source, Diagnostics &diagnostics) {
+    for (const Token &token : source) {
+        if (token.isError()) {
+            reportTokenError(token, diagnostics);
+            SourceSpan at = token.getSpan();
+            co_yield Token(Type::END_OF_FILE, "", SourceSpan{ at.file, at.offset, 0 });
+            co_return;
+        }
+        co_yield token;
+        if (token.isEndOfFile()) {
+            co_return;
+        }
     }
+}
 
-    // Remove Comments
-    string inputFile = argv[1];
-    //string inputFile = "testCases/programming_assignment_5-test_file_2.c";
-    string preprocessedFile = "nocomment_input.txt";
-    IgnoreComments(inputFile, preprocessedFile);
+// Tokens that were lexed up front
+static Generator<Token> tokensOf(const vector<Token> &lexed) {
+    for (const Token &token : lexed) {
+        co_yield token;
+    }
+}
 
-    // Create tokenizer
-    Tokenizer tokenizer(preprocessedFile);
-    TokenList tokens;
-    bool foundError = false;
-    string errorMsg;
+// Run one input through every phase and print what came of it. Returns the
+// exit status for that input.
+static int processFile(const string &inputFile, bool pipelined, bool stats) {
+    Diagnostics diagnostics;
 
-    // Read file and store tokens
-    while (true) {
-        Token token = tokenizer.getToken();
-        if (token.isEndOfFile()) {
-            tokens.push_back(token);
-            break;
-        }
-        if (token.isError()) {
-            foundError = true;
-            // create tokenizer error message
-            switch (token.getType()) {
-                case Type::ERROR_INVALID_INT:
-                    errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": invalid integer\n";
-                    break;
-                case Type::ERROR_UNCLOSED_STRING:
-                    errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": unterminated string quote\n";
-                    break;
-                case Type::ERROR_UNCLOSED_CHAR:
-                    errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": unclosed character literal\n";
-                    break;
-                case Type::ERROR_INVALID_CHAR:
-                    errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": invalid character\n";
-                break;
-                case Type::ERROR_INVALID_OPERATOR:
-                    errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": invalid operator\n";
-                break;
-                case Type::ERROR_INVALID_IDENTIFIER:
-                    errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": invalid identifier\n";
-                break;
-                default:
-                    errorMsg = "Syntax error on line " + std::to_string(token.getLine()) + ": unknown error\n";
-                break;
-            }
-            break;
+    // Streamed input cannot be split up front, so with a spare core it is
+    // lexed alongside the parser instead
+    unsigned threads = thread::hardware_concurrency();
+    if (threads > 1 && inputFile == "-") {
+        pipelined = true;
+    }
+
+    // Create tokenizer (comments are skipped by the tokenizer), "-" streams stdin
+    optional<Tokenizer> tokenizer;
+    optional<TokenPipeline> pipeline;
+    Generator<Token>* source = nullptr;
+    vector<Token> lexed;
+    Generator<Token> lexedStream;
+    if (pipelined) {
+        pipeline.emplace(inputFile);
+        lexedStream = pipeline->tokens();
+        source = &lexedStream;
+    } else {
+        // The parser pulls tokens straight from the tokenizer as it goes. Files
+        // large enough to split are tokenized on every core up front instead.
+        tokenizer.emplace(inputFile);
+        source = &tokenizer->tokens();
+        if (threads > 1 && !tokenizer->isStreamed() && size_t(tokenizer->sourceEnd() - tokenizer->sourceBegin()) >= 2 * MIN_LEX_CHUNK) {
+            lexed = tokenizeParallel(*tokenizer, threads);
+            lexedStream = tokensOf(lexed);
+            source = &lexedStream;
         }
-        tokens.push_back(token);
     }
-    if (foundError) {
-        std::cout << errorMsg << std::endl;
-        exit(1);
+    if (pipeline ? !pipeline->isOpen() : !tokenizer->isOpen()) {
+        diagnostics.report(DiagnosticKind::INPUT, SourceSpan{}, "Error: Could not open file " + inputFile);
+        diagnostics.print(std::cout, std::cerr);
+        return diagnostics.exitStatus();
     }
+    TokenList tokens(checkedTokens(*source, diagnostics));
 
     //Debug Print:
     //tokens.printAllTokens();
 
     //Begin Recursive Descent Parsing (Create CST)
-    Parser parser(tokens);
+    Parser parser(tokens, diagnostics);
     Node* CST = parser.parse();
+    // A tokenizer error past the last token the parser needed still counts
+    tokens.drain();
+    if (stats && pipeline) {
+        pipeline->printStats(std::cerr);
+    }
+    // Without a whole tree there is nothing to build symbols from
+    if (diagnostics.stopsBeforeSymbols()) {
+        diagnostics.print(std::cout, std::cerr);
+        return diagnostics.exitStatus();
+    }
 
     //parser.graphicPrintTree(CST);
     //root->printTree();
@@ -91,16 +147,19 @@ int main(int argc, char* argv[]) {
     //terminalCST->printTree();
 
     //Create Symbol Table
-    SymbolTable symbolTable;
+    SymbolTable symbolTable(diagnostics);
     traverseCST(CST, 0, symbolTable);
-    if (!symbolError) {
+    if (!symbolTable.hasErrors()) {
         //symbolTable.print();
     }
 
     //Create AST
-    AST ast(terminalCST, &symbolTable);
-    ASTNode* astRoot = ast.root();
-    ast.printAST(astRoot);
+    AST ast(terminalCST, &symbolTable, diagnostics);
+    diagnostics.print(std::cout, std::cerr);
+    if (!diagnostics.has(DiagnosticKind::INTERNAL)) {
+        ASTNode* astRoot = ast.root();
+        ast.printAST(astRoot);
+    }
 
     /*if (root) {
         std::ofstream outFile("cst_output.txt");
@@ -112,5 +171,62 @@ int main(int argc, char* argv[]) {
         parser.printTree(root);
         outFile.close();
     }*/
-    return 0;
+    return diagnostics.exitStatus();
+}
+
+// Print every token of one input up to END_OF_FILE, one per line as
+// TYPE|text|line. testCases/tokens holds what the tokenizer gave before it
+// was driven from a table, make check-tokens compares against it.
+static int dumpTokens(const string &inputFile) {
+    Tokenizer tokenizer(inputFile);
+    if (!tokenizer.isOpen()) {
+        std::cerr << "Error: Could not open file " << inputFile << "\n";
+        return 1;
+    }
+    while (true) {
+        Token token = tokenizer.getToken();
+        std::cout << token.getTypeName() << "|" << token.getText() << "|" << token.getLine() << "\n";
+        if (token.isEndOfFile()) {
+            return 0;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // --pipeline: lex on a thread of its own, --stats: report how the
+    // pipeline stages kept up with each other, --tokens: only print the
+    // tokens of each input
+    vector<string> inputFiles;
+    bool pipelined = false;
+    bool stats = false;
+    bool tokensOnly = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--pipeline") {
+            pipelined = true;
+        } else if (arg == "--stats") {
+            stats = true;
+        } else if (arg == "--tokens") {
+            tokensOnly = true;
+        } else {
+            inputFiles.push_back(arg);
+        }
+    }
+    if (inputFiles.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--pipeline] [--stats] [--tokens] <inputFile | ->...\n";
+        return 1;
+    }
+    //string inputFile = "testCases/programming_assignment_5-test_file_2.c";
+
+    // Every input is processed whatever happened to the ones before it, the
+    // exit status is the worst of theirs
+    int status = 0;
+    for (const string &inputFile : inputFiles) {
+        if (tokensOnly) {
+            status = max(status, dumpTokens(inputFile));
+            continue;
+        }
+        status = max(status, processFile(inputFile, pipelined, stats));
+    }
+    return status;
 }
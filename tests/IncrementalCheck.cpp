@@ -0,0 +1,125 @@
+/** ***************************************************************************
+ * @remark Checks retokenize() against a full re-lex: random sources go     *
+ *          through chains of random edits (inserts, deletes and replaces    *
+ *          that open or close comments and literals too), and after every   *
+ *          edit each token field must match a fresh tokenization of the     *
+ *          edited source.                                                   *
+ *                                                                            *
+ * @file  IncrementalCheck.cpp                                                *
+ *****************************************************************************/
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "IncrementalTokenizer.h"
+#include "LiteralPool.h"
+#include "NamePool.h"
+#include "SourceMap.h"
+#include "Tokenizer.h"
+
+using namespace std;
+
+static int failures = 0;
+
+static void fail(const string &what) {
+    if (failures++ < 20) {
+        cerr << "FAIL: " << what << "\n";
+    }
+}
+
+// A file of sourceMap() over source, so token lines can be looked up
+static FileId addSource(const string &source) {
+    FileId file = sourceMap().addFile("<check>");
+    sourceMap().lines(file).setText(source.data(), source.data() + source.size());
+    return file;
+}
+
+static vector<Token> lexAll(const string &source) {
+    Tokenizer tokenizer(source.data(), source.data(), source.data() + source.size(), addSource(source),
+                        namePool(), literalPool());
+    vector<Token> tokens;
+    do {
+        tokens.push_back(tokenizer.getToken());
+    } while (!tokens.back().isEndOfFile());
+    return tokens;
+}
+
+static bool sameTokens(const vector<Token> &a, const vector<Token> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].getType() != b[i].getType() || a[i].getOffset() != b[i].getOffset()
+            || a[i].getLength() != b[i].getLength() || a[i].getLine() != b[i].getLine()
+            || a[i].getNameId() != b[i].getNameId() || a[i].getLiteral() != b[i].getLiteral()
+            || a[i].getText() != b[i].getText()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const char* const PIECES[] = {
+    "int x;\n", "x = -1 + y2 * (z % 3);\n", "if (a <= b && c != d) {\n", "}\n",
+    "// line comment\n", "/* block\n comment */", "/*", "*/", "\"string\"", "\"escaped \\\n newline\"",
+    "'c'", "'\\''", "\"", "'", "\\", "\n", "  ", "printf (\"%d\\n\", x);\n", "-", "7", "abc",
+};
+
+static string randomText(mt19937 &rng, size_t pieces) {
+    string text;
+    for (size_t i = 0; i < pieces; i++) {
+        text += PIECES[rng() % size(PIECES)];
+    }
+    return text;
+}
+
+// Applies random edits to source one after another, checking each result
+static void checkEdits(string source, const string &name, mt19937 &rng, int edits) {
+    vector<Token> tokens = lexAll(source);
+    for (int step = 0; step < edits; step++) {
+        uint32_t offset = rng() % (source.size() + 1);
+        uint32_t removed = rng() % 3 == 0 ? 0 : rng() % min<size_t>(source.size() - offset + 1, 40);
+        string inserted = rng() % 3 == 0 ? string() : randomText(rng, 1 + rng() % 3);
+        // The old text is gone by the time retokenize() runs
+        source = source.substr(0, offset) + inserted + source.substr(offset + removed);
+        SourceEdit edit{ offset, removed, static_cast<uint32_t>(inserted.size()) };
+        retokenize(tokens, source.data(), source.data() + source.size(), edit);
+        if (!sameTokens(tokens, lexAll(source))) {
+            fail(name + " differs from a full re-lex after edit " + to_string(step));
+            return;
+        }
+    }
+}
+
+int main() {
+    mt19937 rng(460);
+    size_t cases = 0;
+    for (const auto &entry : filesystem::directory_iterator("testCases")) {
+        if (entry.path().extension() != ".c") {
+            continue;
+        }
+        ifstream in(entry.path(), ios::binary);
+        ostringstream text;
+        text << in.rdbuf();
+        checkEdits(text.str(), entry.path().filename().string(), rng, 50);
+        cases++;
+    }
+    if (cases == 0) {
+        fail("no test cases in testCases/");
+    }
+
+    for (int round = 0; round < 300; round++) {
+        checkEdits(randomText(rng, rng() % 40), "random input " + to_string(round), rng, 20);
+    }
+
+    if (failures > 0) {
+        cerr << failures << " incremental checks failed\n";
+        return 1;
+    }
+    cout << "edited tokens match (" << cases << " test cases, 300 random inputs)\n";
+    return 0;
+}
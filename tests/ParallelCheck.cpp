@@ -0,0 +1,120 @@
+/** ***************************************************************************
+ * @remark Checks tokenizeParallel() against the serial tokenizer: for 2 to  *
+ *          16 threads and chunks down to a single byte, every token field   *
+ *          must match, on the test cases and on random sources full of      *
+ *          comments, quotes and escaped newlines that make the chunk        *
+ *          guesses go wrong.                                                *
+ *                                                                            *
+ * @file  ParallelCheck.cpp                                                   *
+ *****************************************************************************/
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "LiteralPool.h"
+#include "NamePool.h"
+#include "ParallelTokenizer.h"
+#include "SourceMap.h"
+#include "Tokenizer.h"
+
+using namespace std;
+
+static int failures = 0;
+
+static void fail(const string &what) {
+    if (failures++ < 20) {
+        cerr << "FAIL: " << what << "\n";
+    }
+}
+
+// A file of sourceMap() over source, so token lines can be looked up
+static FileId addSource(const string &source) {
+    FileId file = sourceMap().addFile("<check>");
+    sourceMap().lines(file).setText(source.data(), source.data() + source.size());
+    return file;
+}
+
+static vector<Token> serialTokens(const string &source, FileId file) {
+    Tokenizer tokenizer(source.data(), source.data(), source.data() + source.size(), file, namePool(),
+                        literalPool());
+    vector<Token> tokens;
+    do {
+        tokens.push_back(tokenizer.getToken());
+    } while (!tokens.back().isEndOfFile());
+    return tokens;
+}
+
+static bool sameToken(const Token &a, const Token &b) {
+    return a.getType() == b.getType() && a.getOffset() == b.getOffset() && a.getLength() == b.getLength()
+           && a.getLine() == b.getLine() && a.getNameId() == b.getNameId() && a.getLiteral() == b.getLiteral();
+}
+
+static void check(const string &source, const string &name) {
+    FileId file = addSource(source);
+    vector<Token> expected = serialTokens(source, file);
+    for (unsigned threads : { 2u, 3u, 5u, 8u, 16u }) {
+        for (size_t minChunk : { size_t(1), size_t(7), size_t(64) }) {
+            Tokenizer tokenizer(source.data(), source.data(), source.data() + source.size(), file, namePool(),
+                                literalPool());
+            vector<Token> tokens = tokenizeParallel(tokenizer, threads, minChunk);
+            bool same = tokens.size() == expected.size();
+            for (size_t i = 0; same && i < tokens.size(); i++) {
+                same = sameToken(tokens[i], expected[i]);
+            }
+            if (!same) {
+                fail(name + " differs with " + to_string(threads) + " threads, chunks of at least "
+                     + to_string(minChunk) + " bytes");
+            }
+        }
+    }
+}
+
+// Lines of code, comments and literals whose chunk boundaries often fall
+// inside a comment or an escaped-newline literal
+static string randomSource(mt19937 &rng) {
+    static const char* const pieces[] = {
+        "int x;\n", "x = -1 + y2 * (z % 3);\n", "if (a <= b && c != d) {\n", "}\n",
+        "// line comment /* not a block\n", "/* block\n comment\n */", "/*", "*/", "/* \" ' */",
+        "\"string // not a comment\"", "\"escaped \\\n newline\"", "'\\''", "'\\\n'", "\"unclosed\n",
+        "'", "\"", "\\", "\n", "  \t", "printf (\"%d\\n\", x);\n", "function int f (int a)\n",
+    };
+    string source;
+    size_t count = rng() % 60;
+    for (size_t i = 0; i < count; i++) {
+        source += pieces[rng() % size(pieces)];
+    }
+    return source;
+}
+
+int main() {
+    size_t cases = 0;
+    for (const auto &entry : filesystem::directory_iterator("testCases")) {
+        if (entry.path().extension() != ".c") {
+            continue;
+        }
+        ifstream in(entry.path(), ios::binary);
+        ostringstream text;
+        text << in.rdbuf();
+        check(text.str(), entry.path().filename().string());
+        cases++;
+    }
+    if (cases == 0) {
+        fail("no test cases in testCases/");
+    }
+
+    mt19937 rng(460);
+    for (int round = 0; round < 300; round++) {
+        check(randomSource(rng), "random input " + to_string(round));
+    }
+
+    if (failures > 0) {
+        cerr << failures << " parallel checks failed\n";
+        return 1;
+    }
+    cout << "parallel tokens match (" << cases << " test cases, 300 random inputs)\n";
+    return 0;
+}
@@ -0,0 +1,194 @@
+/** ***************************************************************************
+ * @remark Checks the SSE2/AVX2 scan kernels against the scalar loop they    *
+ *          replace: every kernel must stop on the same byte for every set   *
+ *          and count the same newlines, at every offset and length, and the *
+ *          tokenizer must produce the same token stream under each of them, *
+ *          on the test cases and on random comment and literal heavy        *
+ *          inputs. The character class table and run helpers are checked    *
+ *          against <cctype> the same way.                                   *
+ *                                                                            *
+ * @file  ScanCheck.cpp                                                       *
+ *****************************************************************************/
+
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "ByteScan.h"
+#include "CharClass.h"
+#include "Tokenizer.h"
+
+using namespace std;
+
+static const char* const KERNELS[] = { "scalar", "sse2", "avx2" };
+static int failures = 0;
+
+static void fail(const string &what) {
+    if (failures++ < 20) {
+        cerr << "FAIL: " << what << "\n";
+    }
+}
+
+// Every kernel against scalar on buffers with hits at each position
+static void checkKernels(mt19937 &rng) {
+    const ByteSet sets[] = { ByteSet('\n'), ByteSet('*', '\n'), ByteSet('\\', '"', '\n', '\r'),
+                             ByteSet('\\', '\'', '\n', '\r') };
+    const string alphabet = "ab \t*/\\\"'\n\r\x80\xff";
+    for (int round = 0; round < 200; round++) {
+        size_t length = rng() % 200;
+        string buffer(length + 64, 'x');
+        for (size_t i = 0; i < length; i++) {
+            buffer[i] = rng() % 4 == 0 ? alphabet[rng() % alphabet.size()] : 'a' + rng() % 26;
+        }
+        for (const ByteSet &set : sets) {
+            for (size_t from = 0; from <= length; from++) {
+                const char* begin = buffer.data() + from;
+                const char* end = buffer.data() + length;
+                selectScanKernel("scalar");
+                const char* expected = scanUntil(begin, end, set);
+                size_t newlines = countByte(begin, end, '\n');
+                for (const char* kernel : KERNELS) {
+                    if (!selectScanKernel(kernel)) {
+                        continue;
+                    }
+                    if (scanUntil(begin, end, set) != expected) {
+                        fail(string(kernel) + " stops at a different byte, offset " + to_string(from)
+                             + " of " + to_string(length));
+                    }
+                    if (countByte(begin, end, '\n') != newlines) {
+                        fail(string(kernel) + " counts a different number of newlines, offset "
+                             + to_string(from) + " of " + to_string(length));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// The class table against the <cctype> calls it replaced, and the run
+// helpers against a byte at a time walk over the table
+static void checkCharClasses(mt19937 &rng) {
+    for (int c = 0; c < 128; c++) {
+        char ch = static_cast<char>(c);
+        if (hasCharClass(ch, CC_SPACE) != (isspace(c) != 0) || hasCharClass(ch, CC_DIGIT) != (isdigit(c) != 0)
+            || hasCharClass(ch, CC_ALPHA) != (isalpha(c) != 0)
+            || hasCharClass(ch, CC_IDENT) != (isalnum(c) != 0 || c == '_')
+            || hasCharClass(ch, CC_PUNCT) != (ispunct(c) != 0 && c != '_')) {
+            fail("class table differs from <cctype> for byte " + to_string(c));
+        }
+    }
+    const string alphabet = " \t\n\r\v\f09azAZ_+(\x80\xff";
+    for (int round = 0; round < 200; round++) {
+        size_t length = rng() % 100;
+        string buffer(length + 64, 'x');
+        for (size_t i = 0; i < length; i++) {
+            buffer[i] = alphabet[rng() % alphabet.size()];
+        }
+        for (size_t from = 0; from <= length; from++) {
+            const char* begin = buffer.data() + from;
+            const char* end = buffer.data() + length;
+            const char* space = begin;
+            while (space < end && hasCharClass(*space, CC_SPACE)) {
+                space++;
+            }
+            const char* ident = begin;
+            while (ident < end && hasCharClass(*ident, CC_IDENT)) {
+                ident++;
+            }
+            const char* digit = begin;
+            while (digit < end && hasCharClass(*digit, CC_DIGIT)) {
+                digit++;
+            }
+            if (spaceRunEnd(begin, end) != space) {
+                fail("spaceRunEnd differs at offset " + to_string(from));
+            }
+            if (identRunEnd(begin, end) != ident) {
+                fail("identRunEnd differs at offset " + to_string(from));
+            }
+            if (digitRunEnd(begin, end) != digit) {
+                fail("digitRunEnd differs at offset " + to_string(from));
+            }
+        }
+    }
+}
+
+// The token stream of a file as one line per token
+static vector<string> tokensOf(const string &path) {
+    vector<string> lines;
+    Tokenizer tokenizer(path);
+    while (true) {
+        Token token = tokenizer.getToken();
+        lines.push_back(string(token.getTypeName()) + "|" + string(token.getText()) + "|"
+                        + to_string(token.getLine()));
+        if (token.isEndOfFile() || token.getType() == Type::ERROR_UNCLOSED_COMMENT) {
+            return lines;
+        }
+    }
+}
+
+static void checkTokens(const string &path, const string &name) {
+    selectScanKernel("scalar");
+    vector<string> expected = tokensOf(path);
+    for (const char* kernel : KERNELS) {
+        if (selectScanKernel(kernel) && tokensOf(path) != expected) {
+            fail(string(kernel) + " changes the tokens of " + name);
+        }
+    }
+}
+
+// Short programs made mostly of comments, strings and char literals, with
+// escapes, stray newlines and unterminated pieces
+static string randomSource(mt19937 &rng) {
+    static const char* const pieces[] = {
+        "// line comment ****\n", "/* block\n * comment **/", "/***/", "/* unclosed ",
+        "\"string with \\\" escape\"", "\"unclosed\n", "'c'", "'\\''", "'\n", "x = 1;\n",
+        "int a;", "    ", "\n", "*", "/", "\\", "\"", "'", "\r\n",
+    };
+    string source;
+    size_t count = rng() % 40;
+    for (size_t i = 0; i < count; i++) {
+        source += pieces[rng() % size(pieces)];
+        if (rng() % 3 == 0) {
+            source += string(rng() % 70, 'a' + rng() % 26);
+        }
+    }
+    return source;
+}
+
+int main() {
+    mt19937 rng(460);
+    checkKernels(rng);
+    checkCharClasses(rng);
+
+    vector<filesystem::path> cases;
+    for (const auto &entry : filesystem::directory_iterator("testCases")) {
+        if (entry.path().extension() == ".c") {
+            cases.push_back(entry.path());
+        }
+    }
+    if (cases.empty()) {
+        fail("no test cases in testCases/");
+    }
+    for (const filesystem::path &path : cases) {
+        checkTokens(path.string(), path.filename().string());
+    }
+
+    string scratch = (filesystem::temp_directory_path() / "scancheck.c").string();
+    for (int round = 0; round < 500; round++) {
+        string source = randomSource(rng);
+        ofstream(scratch, ios::binary) << source;
+        checkTokens(scratch, "random input " + to_string(round));
+    }
+    remove(scratch.c_str());
+
+    if (failures > 0) {
+        cerr << failures << " scan checks failed\n";
+        return 1;
+    }
+    cout << "scan kernels and character classes match (" << cases.size() << " test cases, 500 random inputs)\n";
+    return 0;
+}
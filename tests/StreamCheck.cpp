@@ -0,0 +1,160 @@
+/** ***************************************************************************
+ * @remark Checks streamed input against mapped input: every source is fed  *
+ *          to Tokenizer("-") through a pipe on standard input, and each     *
+ *          token's type, text, line and interned ids must match the tokens  *
+ *          of the same bytes tokenized in memory. The random sources span   *
+ *          several input blocks, so comments, literals and escaped          *
+ *          newlines fall across block boundaries.                           *
+ *                                                                            *
+ * @file  StreamCheck.cpp                                                     *
+ *****************************************************************************/
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "InputStream.h"
+#include "LiteralPool.h"
+#include "NamePool.h"
+#include "SourceMap.h"
+#include "Tokenizer.h"
+
+using namespace std;
+
+static int failures = 0;
+
+static void fail(const string &what) {
+    if (failures++ < 20) {
+        cerr << "FAIL: " << what << "\n";
+    }
+}
+
+// The fields that do not depend on where the text lives
+static string describe(const Token &token) {
+    return string(token.getTypeName()) + "|" + string(token.getText()) + "|" + to_string(token.getLine()) + "|"
+           + to_string(token.getNameId()) + "|" + to_string(token.getLiteral());
+}
+
+// A file of sourceMap() over source, so token lines can be looked up
+static FileId addSource(const string &source) {
+    FileId file = sourceMap().addFile("<check>");
+    sourceMap().lines(file).setText(source.data(), source.data() + source.size());
+    return file;
+}
+
+static vector<string> mappedTokens(const string &source) {
+    Tokenizer tokenizer(source.data(), source.data(), source.data() + source.size(), addSource(source),
+                        namePool(), literalPool());
+    vector<string> tokens;
+    while (true) {
+        Token token = tokenizer.getToken();
+        tokens.push_back(describe(token));
+        if (token.isEndOfFile()) {
+            return tokens;
+        }
+    }
+}
+
+// Tokens of source read from standard input, written to it by another thread
+static vector<string> streamedTokens(const string &source) {
+    int ends[2];
+    if (pipe(ends) != 0) {
+        perror("pipe");
+        exit(1);
+    }
+    int savedStdin = dup(0);
+    dup2(ends[0], 0);
+    close(ends[0]);
+    thread writer([&source, fd = ends[1]] {
+        size_t done = 0;
+        while (done < source.size()) {
+            ssize_t n = write(fd, source.data() + done, source.size() - done);
+            if (n <= 0) {
+                break;
+            }
+            done += n;
+        }
+        close(fd);
+    });
+    vector<string> tokens;
+    {
+        Tokenizer tokenizer("-");
+        while (true) {
+            Token token = tokenizer.getToken();
+            tokens.push_back(describe(token));
+            if (token.isEndOfFile()) {
+                break;
+            }
+        }
+    }
+    writer.join();
+    dup2(savedStdin, 0);
+    close(savedStdin);
+    return tokens;
+}
+
+static void check(const string &source, const string &name) {
+    if (streamedTokens(source) != mappedTokens(source)) {
+        fail(name + " is tokenized differently from stdin");
+    }
+}
+
+// Sources over several input blocks, long comments and literals included
+static string randomSource(mt19937 &rng, size_t bytes) {
+    static const char* const pieces[] = {
+        "int x;\n", "x = -1 + y2 * (z % 3);\n", "if (a <= b && c != d) {\n", "}\n",
+        "// line comment\n", "/* block\n comment */", "\"string\"", "\"escaped \\\n newline\"",
+        "'c'", "'\\''", "printf (\"%d\\n\", x);\n", "  ", "\n", "12345 ", "2147483648 ",
+    };
+    string source;
+    while (source.size() < bytes) {
+        if (rng() % 50 == 0) {
+            // A comment or literal long enough to cross a block by itself
+            bool comment = rng() % 2 == 0;
+            source += comment ? "/*" : "\"";
+            for (size_t n = rng() % (InputStream::BLOCK_SIZE / 2); n > 0; n--) {
+                source += comment ? "ab\n*"[rng() % 4] : "ab \\"[rng() % 4];
+            }
+            source += comment ? "*/\n" : "x\"\n";
+        } else {
+            source += pieces[rng() % size(pieces)];
+        }
+    }
+    return source;
+}
+
+int main() {
+    size_t cases = 0;
+    for (const auto &entry : filesystem::directory_iterator("testCases")) {
+        if (entry.path().extension() != ".c") {
+            continue;
+        }
+        ifstream in(entry.path(), ios::binary);
+        ostringstream text;
+        text << in.rdbuf();
+        check(text.str(), entry.path().filename().string());
+        cases++;
+    }
+    if (cases == 0) {
+        fail("no test cases in testCases/");
+    }
+
+    mt19937 rng(460);
+    const int rounds = 12;
+    for (int round = 0; round < rounds; round++) {
+        check(randomSource(rng, rng() % (3 * InputStream::BLOCK_SIZE)), "random input " + to_string(round));
+    }
+    check("int x; /* unterminated\n" + string(InputStream::BLOCK_SIZE, 'a'), "unterminated comment");
+
+    if (failures > 0) {
+        cerr << failures << " stream checks failed\n";
+        return 1;
+    }
+    cout << "streamed tokens match (" << cases << " test cases, " << rounds << " random inputs)\n";
+    return 0;
+}
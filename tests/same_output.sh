@@ -0,0 +1,19 @@
+#!/bin/sh
+# Usage: same_output.sh "<command A>" "<command B>" <input>
+# Runs both commands on the input and fails, showing the difference, if
+# their stdout, stderr or exit status differ.
+a=$1
+b=$2
+input=$3
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+$a "$input" > "$dir/a.out" 2> "$dir/a.err"
+echo $? > "$dir/a.status"
+$b "$input" > "$dir/b.out" 2> "$dir/b.err"
+echo $? > "$dir/b.status"
+for part in out err status; do
+    if ! diff -u "$dir/a.$part" "$dir/b.$part"; then
+        echo "$input: \"$a\" and \"$b\" differ" >&2
+        exit 1
+    fi
+done